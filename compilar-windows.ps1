@@ -67,8 +67,24 @@ $CXXFLAGS_PARALELO = "$CXXFLAGS $openmpFlag"
 $PARALELO_SRCS = @(
     "src/main-paralelo.cpp",
     "src/secuencial.cpp",
+    "src/poda.cpp",
+    "src/afin.cpp",
     "src/paralelo.cpp",
+    "src/hirschberg.cpp",
+    "src/lote.cpp",
+    "src/tuberia.cpp",
+    "src/simd_estriado.cpp",
+    "src/banda.cpp",
+    "src/bitparalelo.cpp",
+    "src/matriz_dp.cpp",
+    "src/matriz_direcciones.cpp",
+    "src/espacio_trabajo.cpp",
+    "src/traceback.cpp",
     "src/puntuacion.cpp",
+    "src/secuencia_dna.cpp",
+    "src/archivo_proyectado.cpp",
+    "src/fasta_mapeado.cpp",
+    "src/secuencias_binarias.cpp",
     "src/utilidades.cpp"
 )
 
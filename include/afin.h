@@ -0,0 +1,209 @@
+#ifndef AFIN_H
+#define AFIN_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "tipos.h"
+#include "matriz_dp.h"
+
+struct EspacioTrabajo;
+
+/**
+ * @file afin.h
+ * @brief Needleman–Wunsch con gap afín (Gotoh) para DNA.
+ *
+ * Un gap de longitud k puntúa apertura + k·gap (EsquemaPuntuacionDNA). Se
+ * mantienen tres estados por celda:
+ *   E(i, j) = max(E(i, j-1) + gap, H(i, j-1) + apertura + gap)   (gap en A)
+ *   F(i, j) = max(F(i-1, j) + gap, H(i-1, j) + apertura + gap)   (gap en B)
+ *   H(i, j) = max(H(i-1, j-1) + s(a_i, b_j), E(i, j), F(i, j))
+ * H, E y F solo se guardan en filas (o diagonales) rodantes; para el
+ * traceback basta un byte de estado por celda (MatrizEstadosAfin), de modo
+ * que la memoria es la cuarta parte de la de AlgNW con MatrizDP.
+ */
+
+/** @brief Valor -infinito de E/F en la frontera (margen para sumar penalidades). */
+const int AFIN_MENOS_INFINITO = -(1 << 29);
+
+/**
+ * @brief Bits del byte de estado de una celda afín.
+ *
+ * Los dos bits bajos dicen de dónde sale H(i, j) (mismos valores que
+ * Direccion: diagonal, arriba = F, izquierda = E). Los bits 2 y 3 indican si
+ * E(i, j) y F(i, j) extienden un gap (vienen de E(i, j-1) / F(i-1, j)) en
+ * lugar de abrirlo desde H.
+ */
+const unsigned char AFIN_ORIGEN_H = 3;
+const unsigned char AFIN_EXTIENDE_E = 4;
+const unsigned char AFIN_EXTIENDE_F = 8;
+
+/**
+ * @brief Byte de estado de una celda a partir de los candidatos ya calculados.
+ *
+ * Misma prioridad ante empates que elegirDireccion (diagonal, arriba,
+ * izquierda); sin saltos para que los bucles "omp simd" vectoricen.
+ */
+inline unsigned char estadoCeldaAfin(int coincidencia, int abre_e, int extiende_e,
+                                     int abre_f, int extiende_f) {
+    int e = (abre_e >= extiende_e) ? abre_e : extiende_e;
+    int f = (abre_f >= extiende_f) ? abre_f : extiende_f;
+    int lateral = 1 + (f < e);
+    int mejor_lateral = (f >= e) ? f : e;
+    return static_cast<unsigned char>((coincidencia < mejor_lateral) * lateral
+                                      | (extiende_e > abre_e) * AFIN_EXTIENDE_E
+                                      | (extiende_f > abre_f) * AFIN_EXTIENDE_F);
+}
+
+/**
+ * @brief Matriz de bytes de estado para el traceback afín.
+ *
+ * Disposición por filas (cada fila empieza en línea de caché propia) o por
+ * diagonales (cada antidiagonal contigua por i, como MatrizDP con
+ * DISPOSICION_DIAGONALES), para que el motor antidiagonal escriba su frente
+ * de forma consecutiva. No copiable.
+ */
+class MatrizEstadosAfin {
+public:
+    /** @brief Matriz vacía (0 x 0), para dimensionarla después con redimensionar. */
+    MatrizEstadosAfin();
+
+    /**
+     * @param filas Número de filas (m + 1).
+     * @param columnas Número de columnas (n + 1).
+     * @param disposicion DISPOSICION_FILAS o DISPOSICION_DIAGONALES.
+     */
+    MatrizEstadosAfin(int filas, int columnas, DisposicionMatriz disposicion = DISPOSICION_FILAS);
+
+    /**
+     * @brief Cambia dimensiones y disposición conservando el buffer si es suficiente.
+     *
+     * Las celdas quedan sin inicializar; los motores afines escriben todas
+     * las celdas con i, j >= 1, que son las únicas que lee tracebackAfin.
+     */
+    void redimensionar(int filas, int columnas, DisposicionMatriz disposicion = DISPOSICION_FILAS);
+
+    MatrizEstadosAfin(const MatrizEstadosAfin&) = delete;
+    MatrizEstadosAfin& operator=(const MatrizEstadosAfin&) = delete;
+
+    int filas() const { return filas_; }
+    int columnas() const { return columnas_; }
+
+    unsigned char operator()(int i, int j) const {
+        if (disposicion_ == DISPOSICION_DIAGONALES) {
+            int d = i + j;
+            return datos_[inicio_diagonal_[d] + (i - primeraFilaDiagonal(d))];
+        }
+        return datos_[static_cast<std::size_t>(i) * stride_ + j];
+    }
+
+    /** @brief Fila i (solo disposición por filas). */
+    unsigned char* fila(int i) { return datos_.data() + static_cast<std::size_t>(i) * stride_; }
+
+    /** @brief Menor fila i presente en la antidiagonal d. */
+    int primeraFilaDiagonal(int d) const {
+        return (d - (columnas_ - 1) > 0) ? d - (columnas_ - 1) : 0;
+    }
+
+    /** @brief Primera celda de la antidiagonal d (solo disposición por diagonales). */
+    unsigned char* diagonal(int d) { return datos_.data() + inicio_diagonal_[d]; }
+
+    std::size_t bytes() const { return datos_.size(); }
+
+    /** @brief Bytes reservados (>= bytes(), tras redimensionar a menos). */
+    std::size_t reservado() const { return datos_.capacity(); }
+
+private:
+    std::vector<unsigned char> datos_;
+    int filas_;
+    int columnas_;
+    std::size_t stride_;
+    DisposicionMatriz disposicion_;
+    std::vector<std::size_t> inicio_diagonal_;
+};
+
+/**
+ * @brief Traceback afín: recorre H/E/F según los bytes de estado.
+ *
+ * Un gap abierto se sigue mientras su bit de extensión esté activo; la fila y
+ * columna 0 son un único gap hasta (0, 0).
+ *
+ * @param estados Matriz de estados ya llena (celdas con i, j >= 1).
+ * @param secA Secuencia A original.
+ * @param secB Secuencia B original.
+ * @param config Configuración (salida_cigar).
+ * @param alineadaA Salida: A con gaps (vacía en modo CIGAR).
+ * @param alineadaB Salida: B con gaps (vacía en modo CIGAR).
+ * @param cigar Salida: CIGAR (vacío si no se pidió).
+ */
+void tracebackAfin(const MatrizEstadosAfin& estados,
+                   const std::string& secA, const std::string& secB,
+                   const ConfiguracionAlineamiento& config,
+                   std::string& alineadaA, std::string& alineadaB,
+                   std::string& cigar);
+
+/** @brief tracebackAfin anotando el camino en un buffer del llamador (pasos). */
+void tracebackAfin(const MatrizEstadosAfin& estados,
+                   const std::string& secA, const std::string& secB,
+                   const ConfiguracionAlineamiento& config,
+                   std::string& alineadaA, std::string& alineadaB,
+                   std::string& cigar, std::string& pasos);
+
+/**
+ * @brief Alineamiento NW con gap afín (Gotoh), secuencial.
+ *
+ * Filas rodantes de H y F, E en registro; un byte de estado por celda para el
+ * traceback. Con apertura = 0 da la misma puntuación que AlgNW.
+ *
+ * @param secA Secuencia A (DNA).
+ * @param secB Secuencia B (DNA).
+ * @param config Configuración de alineamiento (usa parametros.apertura).
+ * @return ResultadoAlineamiento con alineamiento, puntuación y tiempos.
+ */
+ResultadoAlineamiento alineamientoNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Solo la puntuación NW con gap afín (sin matriz de estados ni traceback).
+ *
+ * @return ResultadoAlineamiento con solo_puntuacion = true.
+ */
+ResultadoAlineamiento puntuacionNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/** @brief alineamientoNWAfin con la memoria de espacio (estados, filas, códigos y camino). */
+ResultadoAlineamiento alineamientoNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief puntuacionNWAfin con la memoria de espacio. */
+ResultadoAlineamiento puntuacionNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/**
+ * @brief Puntuación NW afín de dos secuencias ya codificadas (como puntuacionNWCodificada).
+ *
+ * perfil es el perfil de consulta de codB (siempre necesario con gap afín);
+ * H y F salen de espacio.anterior y espacio.actual.
+ *
+ * @return Puntuación NW afín óptima.
+ */
+int puntuacionNWAfinCodificada(const std::string& codA, const std::string& codB,
+                               const std::vector<int>& perfil,
+                               const ConfiguracionAlineamiento& config,
+                               EspacioTrabajo& espacio);
+
+#endif // AFIN_H
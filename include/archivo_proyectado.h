@@ -0,0 +1,47 @@
+#ifndef ARCHIVO_PROYECTADO_H
+#define ARCHIVO_PROYECTADO_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file archivo_proyectado.h
+ * @brief Archivo completo proyectado en memoria de solo lectura (mmap).
+ */
+
+/**
+ * @brief Contenido de un archivo accesible como un bloque de bytes.
+ *
+ * Con mmap las páginas las comparte la caché del sistema y no se copia
+ * nada. En Windows, o si el archivo no es regular (p. ej. una tubería), se
+ * lee de una vez a un buffer propio.
+ */
+class ArchivoProyectado {
+public:
+    /**
+     * @brief Proyecta el archivo; si no se puede abrir, abierto() es false (sin mensaje).
+     *
+     * @param precargar true para quien va a recorrer el archivo entero (un
+     *        FASTA de texto): lee todas las páginas al proyectar (MAP_POPULATE
+     *        si existe, y MADV_WILLNEED). Con false cada página se lee al
+     *        tocarla, así que abrir cuesta lo mismo sea cual sea el tamaño.
+     */
+    explicit ArchivoProyectado(const std::string& nombreArchivo, bool precargar = false);
+    ~ArchivoProyectado();
+
+    ArchivoProyectado(const ArchivoProyectado&) = delete;
+    ArchivoProyectado& operator=(const ArchivoProyectado&) = delete;
+
+    bool abierto() const { return abierto_; }
+    const char* datos() const { return datos_; }
+    std::size_t tamano() const { return tamano_; }
+
+private:
+    const char* datos_;
+    std::size_t tamano_;
+    bool abierto_;
+    std::vector<char> copia_;   /**< Contenido del archivo cuando no hay mmap. */
+};
+
+#endif // ARCHIVO_PROYECTADO_H
@@ -0,0 +1,87 @@
+#ifndef BANDA_H
+#define BANDA_H
+
+#include <string>
+#include "tipos.h"
+
+/**
+ * @file banda.h
+ * @brief Needleman–Wunsch restringido a una banda de diagonales (DNA).
+ */
+
+/**
+ * @brief Alineamiento NW calculando solo las celdas con diag_min <= j - i <= diag_max.
+ *
+ * Reserva (m + 1) x (diag_max - diag_min + 1) enteros en lugar de (m + 1) x (n + 1);
+ * las celdas fuera de la banda se tratan como -infinito. La banda se amplía
+ * si hace falta para contener las diagonales 0 y n - m (inicio y fin del
+ * camino). El resultado es el óptimo entre los caminos contenidos en la
+ * banda; coincide con el óptimo global si algún camino óptimo cabe en ella.
+ * El traceback recalcula con la misma prioridad que AlgNW (diagonal,
+ * eliminación, inserción) y respeta config.salida_cigar.
+ *
+ * @param secA Secuencia A (DNA).
+ * @param secB Secuencia B (DNA).
+ * @param config Configuración de alineamiento.
+ * @param diag_min Diagonal mínima j - i de la banda.
+ * @param diag_max Diagonal máxima j - i de la banda.
+ * @return ResultadoAlineamiento con alineamiento, puntuación y tiempos.
+ */
+ResultadoAlineamiento alineamientoNWBanda(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    int diag_min,
+    int diag_max
+);
+
+/** @brief Semiancho inicial de la banda adaptativa (diagonales a cada lado de 0 y n - m). */
+const int SEMIANCHO_BANDA_INICIAL = 64;
+
+/**
+ * @brief Cota de Ukkonen: ¿ningún camino que salga de la banda puede superar
+ *        la puntuación obtenida dentro de ella?
+ *
+ * Un camino que toca la diagonal d tiene al menos G = |d| + |(n - m) - d|
+ * gaps y (m + n - G) / 2 pasos diagonales, así que puntúa a lo sumo
+ * (max(coincidencia, sustitucion)·(m + n - G) + 2·gap·G) / 2. Si 2·gap no es
+ * menor que la mejor sustitución la cota no sirve y solo la matriz completa
+ * garantiza el óptimo.
+ *
+ * @param config Esquema de puntuación (gap lineal).
+ * @param m Longitud de A.
+ * @param n Longitud de B.
+ * @param diag_min Diagonal mínima de la banda ya ajustada.
+ * @param diag_max Diagonal máxima de la banda ya ajustada.
+ * @param puntuacion_banda F(m, n) calculada dentro de la banda.
+ * @return true si puntuacion_banda es el óptimo global.
+ */
+bool bandaGarantizaOptimo(const ConfiguracionPuntuacionDNA& config, int m, int n,
+                          int diag_min, int diag_max, int puntuacion_banda);
+
+/**
+ * @brief Alineamiento NW en banda que duplica el semiancho hasta demostrar el óptimo.
+ *
+ * Empieza con las diagonales [min(0, n - m) - w, max(0, n - m) + w] y, mientras
+ * bandaGarantizaOptimo no lo confirme, repite el llenado con 2·w. Para
+ * secuencias parecidas el coste es O((m + n)·w) en tiempo y memoria; en el
+ * peor caso termina en la matriz completa. El traceback solo se hace sobre la
+ * banda final, y los tiempos de fase 2 suman todos los intentos. Con gap afín
+ * delega en alineamientoNWAfin.
+ *
+ * @param secA Secuencia A (DNA).
+ * @param secB Secuencia B (DNA).
+ * @param config Configuración de alineamiento.
+ * @param semiancho_inicial Semiancho w del primer intento.
+ * @param semiancho_final Salida opcional: semiancho con el que se demostró el óptimo.
+ * @return ResultadoAlineamiento con alineamiento, puntuación y tiempos.
+ */
+ResultadoAlineamiento alineamientoNWBandaAdaptativa(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    int semiancho_inicial = SEMIANCHO_BANDA_INICIAL,
+    int* semiancho_final = nullptr
+);
+
+#endif // BANDA_H
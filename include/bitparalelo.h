@@ -0,0 +1,68 @@
+#ifndef BITPARALELO_H
+#define BITPARALELO_H
+
+#include <string>
+#include "tipos.h"
+
+/**
+ * @file bitparalelo.h
+ * @brief Motor bit-paralelo (Myers/Hyyrö) para esquemas equivalentes a distancia de edición.
+ */
+
+/**
+ * @brief Distancia de Levenshtein entre a y b con el algoritmo bit-vector de Myers/Hyyrö.
+ *
+ * a se reparte en palabras de 64 bits (una fila de la DP por bit) y cada
+ * carácter de b avanza una columna completa con ~15 operaciones por palabra:
+ * 64 celdas por palabra en lugar de una. Dos símbolos coinciden si tienen
+ * el mismo código IUPAC no nulo, como en obtenerPuntuacionDNA sin modo iupac.
+ *
+ * @param a Secuencia dispuesta en los bits (vertical).
+ * @param b Secuencia recorrida columna a columna.
+ * @return int Distancia de edición con costes unitarios.
+ */
+int distanciaEdicionBitParalela(const std::string& a, const std::string& b);
+
+/**
+ * @brief Puntuación NW mediante distancia de edición bit-paralela (sin alineamiento).
+ *
+ * Solo si config.puntuacion.equivalenteDistanciaEdicion(); en otro caso
+ * delega en puntuacionNW. El resultado tiene solo_puntuacion = true.
+ *
+ * @param secA Secuencia A (DNA).
+ * @param secB Secuencia B (DNA).
+ * @param config Configuración de alineamiento.
+ * @return ResultadoAlineamiento con puntuación y tiempos de las fases 1 y 2.
+ */
+ResultadoAlineamiento puntuacionNWBitParalelo(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Alineamiento NW completo: distancia bit-paralela + traceback en banda.
+ *
+ * Con distancia de edición D, todo camino óptimo cumple
+ * |j - i| + |(n - m) - (j - i)| <= D, así que basta una banda de
+ * D - |m - n| diagonales (más las que separan 0 de n - m) alrededor de la
+ * diagonal principal: la DP con la puntuación original se limita a esa
+ * banda (alineamientoNWBanda) y el traceback se hace sobre ella. Para
+ * secuencias parecidas la banda es estrecha y el coste total es O(n·m/64 + D·n).
+ * Si el esquema no es equivalente a distancia de edición se delega en AlgNW.
+ *
+ * El alineamiento es óptimo con la misma puntuación que AlgNW; ante
+ * empates entre caminos óptimos puede elegir otro distinto.
+ *
+ * @param secA Secuencia A (DNA).
+ * @param secB Secuencia B (DNA).
+ * @param config Configuración de alineamiento.
+ * @return ResultadoAlineamiento con alineamiento, puntuación y tiempos.
+ */
+ResultadoAlineamiento alineamientoNWBitParalelo(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+#endif // BITPARALELO_H
@@ -0,0 +1,96 @@
+#ifndef ESPACIO_TRABAJO_H
+#define ESPACIO_TRABAJO_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "matriz_dp.h"
+#include "matriz_direcciones.h"
+#include "afin.h"
+
+/**
+ * @file espacio_trabajo.h
+ * @brief Memoria de trabajo de los motores NW, reutilizable entre alineamientos.
+ *
+ * Cada motor reserva en la fase 1 su matriz (de puntuaciones, de
+ * direcciones o de estados afines), las secuencias codificadas, el perfil
+ * de consulta y sus filas o diagonales auxiliares, y lo libera todo al
+ * terminar. Con pares cortos o repetidos esas reservas (y los fallos de
+ * página de memoria recién obtenida) pesan tanto como el propio llenado.
+ *
+ * Las versiones de los motores que reciben un EspacioTrabajo toman todo eso
+ * de aquí. Los buffers solo crecen, así que a partir del par más grande ya
+ * visto un alineamiento no reserva memoria más que para su resultado.
+ */
+
+/**
+ * @brief Buffers de un alineamiento, propiedad del llamador.
+ *
+ * Un objeto no debe usarlo más de un alineamiento a la vez (con varios
+ * threads, uno por thread). Los motores no suponen nada sobre el contenido
+ * previo de los buffers. No es copiable.
+ */
+struct EspacioTrabajo {
+    std::string codA;            /**< A codificada (codificarIUPAC). */
+    std::string codB;            /**< B codificada (o invertida, según el motor). */
+    std::vector<int> perfil;     /**< Perfil de consulta de B. */
+    std::vector<int> anterior;   /**< Fila/diagonal rodante. */
+    std::vector<int> actual;     /**< Fila/diagonal rodante. */
+    std::vector<int> auxiliar;   /**< Tercera diagonal, esquinas de tesela, etc. */
+    std::vector<int> gaps;       /**< Estados E/F rodantes de los motores afines. */
+    std::vector<char> testigos;  /**< Marcas de teselas terminadas (motor de tareas). */
+    std::string pasos;           /**< Camino del traceback. */
+
+    EspacioTrabajo();
+    ~EspacioTrabajo();
+
+    EspacioTrabajo(const EspacioTrabajo&) = delete;
+    EspacioTrabajo& operator=(const EspacioTrabajo&) = delete;
+
+    /**
+     * @brief Matriz DP filas x columnas en la disposición pedida.
+     *
+     * Sus celdas quedan con lo que tuviera el buffer: el motor debe escribir
+     * cada celda antes de leerla. paginas_grandes como en MatrizDP::redimensionar.
+     */
+    MatrizDP& matriz(int filas, int columnas,
+                     DisposicionMatriz disposicion = DISPOSICION_FILAS,
+                     int tam_bloque = 64,
+                     bool paginas_grandes = true);
+
+    /**
+     * @brief true si la última llamada a matriz() reservó un buffer nuevo.
+     *
+     * Sus páginas no se han escrito todavía: el motor puede repartir la
+     * primera escritura entre los threads que después calcularán cada zona.
+     */
+    bool matrizSinTocar() const { return matriz_sin_tocar_; }
+
+    /** @brief Matriz de estados afín filas x columnas (sin inicializar, como matriz()). */
+    MatrizEstadosAfin& estadosAfin(int filas, int columnas,
+                                   DisposicionMatriz disposicion = DISPOSICION_FILAS);
+
+    /** @brief Matriz de direcciones filas x columnas, con todas las celdas a DIR_DIAGONAL. */
+    MatrizDirecciones& direcciones(int filas, int columnas);
+
+    /**
+     * @brief Bloque de al menos bytes bytes alineado a línea de caché (sin inicializar).
+     *
+     * Para contadores de sincronización entre threads, que no deben compartir
+     * línea con otros datos.
+     */
+    void* contadores(std::size_t bytes);
+
+    /** @brief Memoria reservada en total por el espacio (aproximada: no cuenta cabeceras). */
+    std::size_t bytes() const;
+
+private:
+    MatrizDP matriz_;
+    bool matriz_sin_tocar_;
+    MatrizDirecciones direcciones_;
+    MatrizEstadosAfin estados_afin_;
+    void* contadores_;
+    std::size_t bytes_contadores_;
+};
+
+#endif // ESPACIO_TRABAJO_H
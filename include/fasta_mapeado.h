@@ -0,0 +1,87 @@
+#ifndef FASTA_MAPEADO_H
+#define FASTA_MAPEADO_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "archivo_proyectado.h"
+#include "secuencia_dna.h"
+
+/**
+ * @file fasta_mapeado.h
+ * @brief Lectura de FASTA sobre el archivo proyectado en memoria (mmap).
+ *
+ * En lugar de leer línea a línea y hacer crecer cada secuencia con +=, el
+ * archivo se proyecta entero y se indexa: los límites de registro (">" al
+ * principio de línea) se buscan en paralelo por trozos y cada registro se
+ * recorre una vez, 16 bytes por iteración, para contar sus bases (sin
+ * saltos de línea) y los símbolos que no son IUPAC. Con ese índice cada
+ * secuencia se copia directamente a su destino de tamaño exacto, o se
+ * empaqueta a 2 bits sin pasar por ningún std::string intermedio.
+ *
+ * Sigue el convenio de leerArchivoFasta: lo que haya antes de la primera
+ * cabecera es un registro sin nombre y los registros sin bases se omiten.
+ */
+
+/**
+ * @brief FASTA proyectado en memoria de solo lectura, con un índice de registros.
+ *
+ * La proyección la hace ArchivoProyectado, precargada porque el índice
+ * recorre el archivo entero (en Windows, una sola lectura del archivo).
+ */
+class ArchivoFastaMapeado {
+public:
+    /** @brief Proyecta e indexa el archivo; si no se puede abrir, abierto() es false. */
+    explicit ArchivoFastaMapeado(const std::string& nombreArchivo);
+
+    ArchivoFastaMapeado(const ArchivoFastaMapeado&) = delete;
+    ArchivoFastaMapeado& operator=(const ArchivoFastaMapeado&) = delete;
+
+    bool abierto() const { return archivo_.abierto(); }
+    std::size_t registros() const { return registros_.size(); }
+
+    /** @brief Cabecera del registro r, sin '>' ni salto de línea (vacía si no tiene). */
+    std::string cabecera(std::size_t r) const;
+
+    /** @brief Bases del registro r (sin '\n' ni '\r'). */
+    std::size_t longitud(std::size_t r) const { return registros_[r].bases; }
+
+    /** @brief Símbolos del registro r que no son un código IUPAC ni '-'. */
+    std::size_t invalidas(std::size_t r) const { return registros_[r].invalidas; }
+
+    /** @brief Total de símbolos no IUPAC del archivo. */
+    std::size_t invalidas() const;
+
+    /** @brief Copia las longitud(r) bases del registro r a destino, tal como aparecen. */
+    void copiarBases(std::size_t r, char* destino) const;
+
+    /** @brief Secuencia del registro r (una sola reserva, del tamaño exacto). */
+    std::string secuencia(std::size_t r) const;
+
+    /** @brief Registro r empaquetado a 2 bits, directamente desde el archivo. */
+    SecuenciaDNA empaquetar(std::size_t r) const;
+
+private:
+    /** @brief Registro: cabecera en [cabecera, datos) y líneas de bases en [datos, fin). */
+    struct Registro {
+        std::size_t cabecera;
+        std::size_t datos;
+        std::size_t fin;
+        std::size_t bases;
+        std::size_t invalidas;
+        bool retornos;   /**< true si tiene algún '\r' (CRLF): hay que cortar también por él. */
+    };
+
+    void indexar();
+
+    /** @brief Llama a f(puntero, longitud) por cada tramo de bases del registro r, en orden. */
+    template <typename Funcion>
+    void recorrerTramos(std::size_t r, Funcion f) const;
+
+    ArchivoProyectado archivo_;
+    const char* datos_;
+    std::size_t tamano_;
+    std::vector<Registro> registros_;
+};
+
+#endif // FASTA_MAPEADO_H
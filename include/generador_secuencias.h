@@ -3,6 +3,15 @@
 
 #include <string>
 #include <vector>
+#include "secuencia_dna.h"
+
+/**
+ * @brief Formato de los archivos que escribe el generador.
+ */
+enum FormatoSecuencias {
+    FORMATO_FASTA,     /**< Texto FASTA, 60 bases por línea (.fasta). */
+    FORMATO_BINARIO    /**< Contenedor indexado a 2 bits de secuencias_binarias.h (.nwb). */
+};
 
 /**
  * @brief Par de secuencias DNA generadas y metadatos asociados.
@@ -17,6 +26,17 @@ struct ParSecuenciasDNA {
         : sec1(s1), sec2(s2), similitud_real(sim) {}
 };
 
+/**
+ * @brief Par de secuencias DNA empaquetadas a 2 bits por base.
+ */
+struct ParSecuenciasDNAEmpaquetado {
+    SecuenciaDNA sec1;             /**< Primera secuencia. */
+    SecuenciaDNA sec2;             /**< Segunda secuencia. */
+    double similitud_real;         /**< Similitud leída de la cabecera o calculada. */
+    
+    ParSecuenciasDNAEmpaquetado() : similitud_real(0.0) {}
+};
+
 /**
  * @brief Genera una secuencia DNA aleatoria de la longitud especificada.
  * @param longitud Longitud de la secuencia deseada.
@@ -45,6 +65,18 @@ std::string generarSecuenciaDNASimilar(const std::string& original,
  */
 double calcularSimilitudDNA(const std::string& sec1, const std::string& sec2);
 
+/**
+ * @brief Similitud posicional entre secuencias empaquetadas, 32 bases por operación.
+ *
+ * Misma definición que la versión con std::string, salvo que las secuencias
+ * ya están normalizadas a mayúsculas.
+ *
+ * @param sec1 Primera secuencia.
+ * @param sec2 Segunda secuencia.
+ * @return double Similitud entre 0.0 y 1.0 (0.0 si las longitudes difieren).
+ */
+double calcularSimilitudDNA(const SecuenciaDNA& sec1, const SecuenciaDNA& sec2);
+
 /**
  * @brief Genera un par de secuencias DNA con similitud controlada.
  * @param longitud Longitud deseada para cada secuencia.
@@ -56,34 +88,56 @@ ParSecuenciasDNA generarParSecuenciasDNA(int longitud,
 
 /**
  * @brief Guarda un par de secuencias DNA en un archivo FASTA (dos registros).
+ *
+ * Con FORMATO_BINARIO escribe los mismos dos registros, con las mismas
+ * cabeceras, en un contenedor .nwb.
+ *
  * @param par Par de secuencias a guardar.
  * @param nombreArchivo Ruta del archivo de salida.
  * @param id_sec1 Identificador para la primera secuencia (opcional).
  * @param id_sec2 Identificador para la segunda secuencia (opcional).
+ * @param formato FASTA de texto (por defecto) o binario.
  * @return true si se escribió correctamente, false en caso de error.
  */
 bool guardarParSecuenciasDNAFASTA(const ParSecuenciasDNA& par, 
                                   const std::string& nombreArchivo,
                                   const std::string& id_sec1 = "sec1",
-                                  const std::string& id_sec2 = "sec2");
+                                  const std::string& id_sec2 = "sec2",
+                                  FormatoSecuencias formato = FORMATO_FASTA);
 
 /**
  * @brief Carga el primer par de secuencias DNA encontrado en un archivo FASTA.
+ *
+ * También acepta un .nwb (se detecta por su marca, no por la extensión).
+ *
  * @param nombreArchivo Ruta del archivo FASTA de entrada.
  * @return ParSecuenciasDNA Par de secuencias cargado.
  */
 ParSecuenciasDNA cargarParSecuenciasDNAFASTA(const std::string& nombreArchivo);
 
+/**
+ * @brief Carga el primer par de secuencias de un FASTA empaquetándolas a 2 bits por base.
+ *
+ * Las líneas se empaquetan a medida que se leen. Si la cabecera no trae
+ * "similitud=", se calcula con calcularSimilitudDNA.
+ *
+ * @param nombreArchivo Ruta del archivo FASTA de entrada.
+ * @return ParSecuenciasDNAEmpaquetado Par de secuencias cargado.
+ */
+ParSecuenciasDNAEmpaquetado cargarParSecuenciasDNAFASTAEmpaquetado(const std::string& nombreArchivo);
+
 /**
  * @brief Genera múltiples pares de secuencias DNA en lote y los guarda en archivos FASTA.
  * @param directorio_base Directorio donde guardar los archivos.
  * @param longitudes Vector de longitudes a generar.
  * @param similitudes Vector de similitudes objetivo.
+ * @param formato FASTA (dna_lon<L>_sim<S>.fasta) o binario (mismo nombre con .nwb).
  * @return int Número de archivos generados exitosamente.
  */
 int generarLoteSecuenciasDNA(const std::string& directorio_base,
                              const std::vector<int>& longitudes,
-                             const std::vector<double>& similitudes);
+                             const std::vector<double>& similitudes,
+                             FormatoSecuencias formato = FORMATO_FASTA);
 
 #endif // GENERADOR_SECUENCIAS_H
 
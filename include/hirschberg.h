@@ -0,0 +1,46 @@
+#ifndef HIRSCHBERG_H
+#define HIRSCHBERG_H
+
+#include <string>
+#include "tipos.h"
+
+/**
+ * @file hirschberg.h
+ * @brief Needleman–Wunsch en espacio lineal (Hirschberg) con divide y vencerás paralelo (DNA).
+ */
+
+/**
+ * @brief Ejecuta Needleman–Wunsch en espacio O(m+n) usando el esquema de Hirschberg.
+ *
+ * En cada subproblema se calcula la última fila DP de la mitad superior
+ * (hacia adelante) y de la mitad inferior (hacia atrás, sobre las secuencias
+ * invertidas), y se elige la columna de corte que maximiza la suma. Cada corte
+ * fija una celda por la que pasa un camino óptimo; los dos subproblemas
+ * resultantes son independientes y se lanzan como tareas OpenMP, igual que
+ * las dos pasadas de fila de cada nivel.
+ *
+ * Al terminar la recursión se conoce, para cada fila i, la columna por la que
+ * el camino cruza la frontera entre filas; el alineamiento se ensambla en
+ * paralelo resolviendo cada fila (un solo carácter de A frente a un tramo de B)
+ * directamente sobre el buffer de salida.
+ *
+ * Fases instrumentadas:
+ * - Fase 1: reserva del vector de cortes.
+ * - Fase 2: divide y vencerás (pasadas de fila en tareas OpenMP).
+ * - Fase 3: ensamblado paralelo del alineamiento.
+ *
+ * El alineamiento devuelto es óptimo, pero ante empates puede diferir del de
+ * AlgNW (existen varios alineamientos con la misma puntuación).
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene alineamiento, puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWHirschberg(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+#endif // HIRSCHBERG_H
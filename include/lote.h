@@ -0,0 +1,220 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "tipos.h"
+#include "secuencial.h"
+#include "secuencia_dna.h"
+
+/**
+ * @file lote.h
+ * @brief Alineamiento por lotes: muchos pares independientes repartidos entre threads (DNA).
+ *
+ * Los motores de paralelo.h reparten una sola matriz entre threads, y con
+ * pares cortos (128 a 1k bases) la sincronización por frente domina. Aquí
+ * cada par lo resuelve entero un thread con un motor secuencial; el
+ * paralelismo está entre pares, así que el rendimiento escala con el número
+ * de threads mientras haya pares suficientes.
+ *
+ * puntuacionesTodosContraTodos aplica la misma idea a la matriz de
+ * puntuaciones de todos los pares de un multi-FASTA, y buscarEnBaseDatos a
+ * una consulta frente a todas las dianas de una base.
+ */
+
+/** @brief Par a alinear: índices de A y B en la lista de secuencias. */
+struct ParLote {
+    std::size_t a;
+    std::size_t b;
+};
+
+/** @brief Orden en que los threads toman los pares. */
+enum PlanificacionLote {
+    /** Pares por m·n decreciente, uno a uno (dynamic): el más caro no queda para el final. */
+    LOTE_MAS_LARGO_PRIMERO,
+    /**
+     * Cubetas por potencia de 2 de m·n, de la más cara a la más barata; dentro
+     * de cada cubeta los pares se toman en tramos, lo que abarata el reparto
+     * cuando hay miles de pares cortos de coste parecido.
+     */
+    LOTE_CUBETAS
+};
+
+/** @brief Opciones de alinearLote. */
+struct OpcionesLote {
+    bool solo_puntuacion;             /**< true: solo puntuación; false: alineamiento completo. */
+    PlanificacionLote planificacion;  /**< Orden de reparto de los pares. */
+    int threads;                      /**< Threads a usar (0 = omp_get_max_threads()). */
+
+    OpcionesLote()
+        : solo_puntuacion(true), planificacion(LOTE_MAS_LARGO_PRIMERO), threads(0) {}
+};
+
+/** @brief Resultado de un lote completo. */
+struct ResultadoLote {
+    std::vector<ResultadoAlineamiento> resultados;  /**< Uno por par, en el orden de entrada. */
+    std::vector<int> thread;                        /**< Thread que calculó cada par. */
+    double tiempo_total_ms;                         /**< Tiempo de pared del lote. */
+    std::size_t celdas;                             /**< Suma de m·n de todos los pares. */
+    int threads;                                    /**< Threads efectivamente usados. */
+
+    ResultadoLote() : tiempo_total_ms(0.0), celdas(0), threads(0) {}
+};
+
+/**
+ * @brief Pares (0, 1), (2, 3), ... de un FASTA con varios registros.
+ *
+ * Sigue el convenio de main-paralelo (registro 0 frente a registro 1); si el
+ * número de secuencias es impar la última queda sin pareja.
+ */
+std::vector<ParLote> paresConsecutivos(std::size_t num_secuencias);
+
+/**
+ * @brief Alinea todos los pares con paralelismo entre tareas.
+ *
+ * Cada thread mantiene su propio EspacioTrabajo y lo reutiliza en todos
+ * sus pares. Con solo_puntuacion se usa puntuacionNW y, si no, AlgNW
+ * (o los motores de Gotoh con gap afín); config se aplica tal cual a cada
+ * par (IUPAC, CIGAR, X-drop...).
+ *
+ * @param secuencias Secuencias de entrada.
+ * @param pares Pares a alinear (índices en secuencias).
+ * @param config Configuración de alineamiento común.
+ * @param opciones Modo, planificación y número de threads.
+ * @return ResultadoLote con un resultado por par; vacío si algún índice no es válido.
+ */
+ResultadoLote alinearLote(const std::vector<std::string>& secuencias,
+                          const std::vector<ParLote>& pares,
+                          const ConfiguracionAlineamiento& config,
+                          const OpcionesLote& opciones = OpcionesLote());
+
+/**
+ * @brief Alinea un par con el motor secuencial que usa alinearLote para cada par.
+ *
+ * puntuacionNW o AlgNW (según solo_puntuacion) con el espacio dado; con
+ * gap afín, los motores de Gotoh.
+ */
+ResultadoAlineamiento alinearPar(const std::string& secA, const std::string& secB,
+                                 const ConfiguracionAlineamiento& config, bool solo_puntuacion,
+                                 EspacioTrabajo& espacio);
+
+/** @brief Nombre corto de la planificación (para el CSV). */
+const char* nombrePlanificacionLote(PlanificacionLote planificacion);
+
+/**
+ * @brief Matriz simétrica N x N de puntuaciones; solo guarda el triángulo
+ *        superior con la diagonal (N·(N+1)/2 valores).
+ */
+class MatrizPuntuaciones {
+public:
+    explicit MatrizPuntuaciones(std::size_t n = 0) : n_(n), datos_(n * (n + 1) / 2, 0) {}
+
+    std::size_t tamano() const { return n_; }
+    int operator()(std::size_t i, std::size_t j) const { return datos_[indice(i, j)]; }
+    /** @brief Fija S(i, j) = S(j, i) = valor. */
+    void fijar(std::size_t i, std::size_t j, int valor) { datos_[indice(i, j)] = valor; }
+
+    /**
+     * @brief Distancia (S(i, i) + S(j, j)) / 2 - S(i, j).
+     *
+     * Vale 0 en la diagonal y crece con las diferencias; la diagonal es la
+     * puntuación de cada secuencia contra sí misma.
+     */
+    double distancia(std::size_t i, std::size_t j) const {
+        return 0.5 * ((*this)(i, i) + (*this)(j, j)) - (*this)(i, j);
+    }
+
+private:
+    std::size_t indice(std::size_t i, std::size_t j) const {
+        if (i > j) std::swap(i, j);
+        return i * (2 * n_ - i + 1) / 2 + (j - i);
+    }
+
+    std::size_t n_;
+    std::vector<int> datos_;
+};
+
+/** @brief Resultado de puntuacionesTodosContraTodos. */
+struct ResultadoTodosContraTodos {
+    MatrizPuntuaciones puntuaciones;
+    double tiempo_total_ms;   /**< Tiempo de pared (incluye la codificación). */
+    std::size_t celdas;       /**< Suma de m·n de los pares calculados (i <= j). */
+    std::size_t pares;        /**< Pares calculados: N·(N+1)/2. */
+    std::size_t tam_bloque;   /**< Secuencias por bloque de teselas. */
+    int threads;              /**< Threads efectivamente usados. */
+
+    ResultadoTodosContraTodos() : tiempo_total_ms(0.0), celdas(0), pares(0), tam_bloque(0), threads(0) {}
+};
+
+/**
+ * @brief Puntuación NW de todos los pares de secuencias (matriz N x N).
+ *
+ * Por simetría solo se calculan los pares i <= j (la diagonal incluida, que
+ * hace falta para las distancias). Las secuencias se codifican una sola vez
+ * y el espacio de pares se divide en teselas de tam_bloque x tam_bloque
+ * secuencias: en la tesela (bloque I, bloque J) cada secuencia j de J, con
+ * su perfil construido una vez, se compara contra todo el bloque I, que
+ * cabe en caché y se reutiliza para cada j. Las teselas se reparten de la
+ * más cara a la más barata con schedule(dynamic, 1) y cada thread reutiliza
+ * su EspacioTrabajo.
+ *
+ * Con gap afín cada par usa puntuacionNWAfin; X-drop no se aplica (solo
+ * puntuación).
+ *
+ * @param secuencias Secuencias de entrada.
+ * @param config Configuración de alineamiento común.
+ * @param tam_bloque Secuencias por bloque (0 = según la longitud media y los threads).
+ * @param threads Threads a usar (0 = omp_get_max_threads()).
+ * @return ResultadoTodosContraTodos con la matriz simétrica.
+ */
+ResultadoTodosContraTodos puntuacionesTodosContraTodos(const std::vector<std::string>& secuencias,
+                                                       const ConfiguracionAlineamiento& config,
+                                                       std::size_t tam_bloque = 0,
+                                                       int threads = 0);
+
+/** @brief Diana de una búsqueda: índice en la base de datos y puntuación NW. */
+struct AciertoBusqueda {
+    std::size_t indice;
+    int puntuacion;
+};
+
+/** @brief Resultado de buscarEnBaseDatos. */
+struct ResultadoBusqueda {
+    std::vector<AciertoBusqueda> mejores;               /**< Las K mejores, de mayor a menor puntuación. */
+    std::vector<ResultadoAlineamiento> alineamientos;   /**< Alineamiento completo de cada una, mismo orden. */
+    double tiempo_busqueda_ms;                          /**< Puntuación de toda la base (incluye la codificación). */
+    double tiempo_traceback_ms;                         /**< Alineamiento de las K mejores. */
+    std::size_t celdas;                                 /**< Suma de m·n de la fase de puntuación. */
+    int threads;                                        /**< Threads efectivamente usados. */
+
+    ResultadoBusqueda() : tiempo_busqueda_ms(0.0), tiempo_traceback_ms(0.0), celdas(0), threads(0) {}
+};
+
+/**
+ * @brief Busca las K dianas de la base con mejor puntuación NW frente a la consulta.
+ *
+ * La consulta se codifica y su perfil se construye una sola vez; cada thread
+ * recorre dianas con puntuacionNWCodificada (la consulta hace de B) y
+ * mantiene un montículo propio con sus K mejores, que se fusionan al final.
+ * Las dianas siguen empaquetadas: cada thread codifica la suya directamente
+ * de las palabras de 2 bits a su buffer de códigos, y solo las K ganadoras
+ * se desempaquetan para alinearlas con AlgNW (alineamientoNWAfin con gap
+ * afín), de modo que ni el texto ni el traceback cuestan nada en el resto
+ * de la base. Los empates se resuelven a favor del índice menor.
+ *
+ * @param consulta Secuencia consulta.
+ * @param base Dianas, empaquetadas a 2 bits por base.
+ * @param config Configuración común (CIGAR, IUPAC...; X-drop solo afecta al alineamiento final).
+ * @param k Dianas a conservar (si la base tiene menos, todas).
+ * @param threads Threads a usar (0 = omp_get_max_threads()).
+ * @return ResultadoBusqueda con las K mejores y sus alineamientos (consulta como A).
+ */
+ResultadoBusqueda buscarEnBaseDatos(const std::string& consulta,
+                                    const std::vector<SecuenciaDNA>& base,
+                                    const ConfiguracionAlineamiento& config,
+                                    std::size_t k,
+                                    int threads = 0);
+
+#endif // LOTE_H
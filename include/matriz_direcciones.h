@@ -0,0 +1,108 @@
+#ifndef MATRIZ_DIRECCIONES_H
+#define MATRIZ_DIRECCIONES_H
+
+#include <cstddef>
+
+/**
+ * @file matriz_direcciones.h
+ * @brief Matriz de direcciones de traceback empaquetada a 2 bits por celda (DNA).
+ *
+ * Permite a los motores NW guardar el predecesor elegido durante la fase 2 y
+ * conservar solo filas (o diagonales) rodantes de puntuación: para 32k x 32k
+ * son unos 256 MB frente a los ~4 GB de la matriz de enteros.
+ */
+
+/**
+ * @brief Predecesor elegido para una celda (i, j).
+ */
+enum Direccion {
+    DIR_DIAGONAL = 0,   /**< Coincidencia/sustitución: viene de (i-1, j-1). */
+    DIR_ARRIBA = 1,     /**< Eliminación (gap en B): viene de (i-1, j). */
+    DIR_IZQUIERDA = 2   /**< Inserción (gap en A): viene de (i, j-1). */
+};
+
+/**
+ * @brief Elige la dirección con la misma prioridad que el traceback por recálculo.
+ *
+ * Ante empate se prefiere diagonal, luego arriba y luego izquierda, de modo
+ * que el alineamiento obtenido es idéntico al de AlgNW.
+ */
+inline Direccion elegirDireccion(int coincidencia, int eliminacion, int insercion) {
+    // Sin saltos (la elección es impredecible): las comparaciones se usan como 0/1
+    int lateral = DIR_ARRIBA + (eliminacion < insercion);
+    int mejor_lateral = (eliminacion >= insercion) ? eliminacion : insercion;
+    return static_cast<Direccion>((coincidencia < mejor_lateral) * lateral);
+}
+
+/**
+ * @brief Matriz filas x columnas de direcciones, 4 celdas por byte.
+ *
+ * Cada fila ocupa un número entero de líneas de caché, de modo que threads que
+ * escriben filas distintas nunca comparten byte (ni línea). Dentro de una fila
+ * dos threads solo pueden escribir a la vez si sus tramos de columnas empiezan
+ * en múltiplos de 4. Las celdas de la fila 0 y la columna 0 no se escriben: el
+ * traceback las resuelve por posición. La clase no es copiable.
+ */
+class MatrizDirecciones {
+public:
+    /**
+     * @brief Reserva una matriz filas x columnas con todas las celdas a DIR_DIAGONAL.
+     * @param filas Número de filas (m + 1).
+     * @param columnas Número de columnas (n + 1).
+     */
+    MatrizDirecciones(int filas, int columnas);
+
+    /** @brief Matriz vacía; se dimensiona con redimensionar(). */
+    MatrizDirecciones();
+    ~MatrizDirecciones();
+
+    /**
+     * @brief Pasa a filas x columnas con todas las celdas a DIR_DIAGONAL.
+     *
+     * Reutiliza el buffer si cabe (nunca encoge); solo se ponen a cero los
+     * bytes de la matriz nueva.
+     */
+    void redimensionar(int filas, int columnas);
+
+    MatrizDirecciones(const MatrizDirecciones&) = delete;
+    MatrizDirecciones& operator=(const MatrizDirecciones&) = delete;
+
+    int filas() const { return filas_; }
+    int columnas() const { return columnas_; }
+
+    /** @brief Registra la dirección de la celda (i, j) (la celda debe estar a 0). */
+    void fijar(int i, int j, Direccion direccion) {
+        datos_[static_cast<std::size_t>(i) * stride_ + (j >> 2)] |=
+            static_cast<unsigned char>(direccion << ((j & 3) * 2));
+    }
+
+    /**
+     * @brief Puntero al byte que contiene las celdas (i, 4k)..(i, 4k+3), k = j / 4.
+     *
+     * Permite a los bucles internos acumular cuatro direcciones en un registro
+     * y escribir un byte por cada cuatro celdas.
+     */
+    unsigned char* byte(int i, int j) {
+        return datos_ + static_cast<std::size_t>(i) * stride_ + (j >> 2);
+    }
+
+    Direccion obtener(int i, int j) const {
+        return static_cast<Direccion>(
+            (datos_[static_cast<std::size_t>(i) * stride_ + (j >> 2)] >> ((j & 3) * 2)) & 3);
+    }
+
+    /** @brief Bytes que ocupa la matriz actual (incluye relleno). */
+    std::size_t bytes() const { return stride_ * static_cast<std::size_t>(filas_); }
+
+    /** @brief Bytes reservados (>= bytes()). */
+    std::size_t reservado() const { return reservado_; }
+
+private:
+    unsigned char* datos_;
+    std::size_t reservado_;
+    int filas_;
+    int columnas_;
+    std::size_t stride_;
+};
+
+#endif // MATRIZ_DIRECCIONES_H
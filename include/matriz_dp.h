@@ -0,0 +1,198 @@
+#ifndef MATRIZ_DP_H
+#define MATRIZ_DP_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file matriz_dp.h
+ * @brief Matriz de programación dinámica contigua y alineada para los motores NW (DNA).
+ *
+ * Reemplaza a std::vector<std::vector<int>>: un único buffer alineado a línea de
+ * caché en lugar de m+1 reservas independientes, sin indirección por fila.
+ */
+
+/**
+ * @brief Disposición en memoria de las celdas de la matriz.
+ */
+enum DisposicionMatriz {
+    DISPOSICION_FILAS,    /**< Row-major, cada fila rellena hasta múltiplo de línea de caché. */
+    DISPOSICION_BLOQUES,  /**< Teselas cuadradas (potencia de 2) almacenadas contiguamente. */
+    DISPOSICION_DIAGONALES /**< Antidiagonal-mayor: las celdas con i + j = d son contiguas. */
+};
+
+/**
+ * @brief Matriz DP de enteros con buffer contiguo alineado a 64 bytes.
+ *
+ * En disposición por filas la celda (i, j) está en datos[i * stride + j], con
+ * stride múltiplo de 16 enteros (64 bytes) para que cada fila empiece en línea
+ * de caché propia. En disposición por bloques la matriz se divide en teselas
+ * de tam_bloque x tam_bloque (potencia de 2, >= 16); cada tesela es contigua,
+ * de modo que un bloque procesado por un thread ocupa memoria consecutiva.
+ * En disposición por diagonales (sesgada) cada antidiagonal d = i + j se
+ * almacena contigua, ordenada por i y empezando en línea de caché propia, de
+ * modo que un frente de onda se recorre con cargas y escrituras consecutivas.
+ *
+ * La clase no es copiable (las matrices son O(mn)), pero sí movible.
+ */
+class MatrizDP {
+public:
+    static const int ALINEACION_BYTES = 64;                          /**< Tamaño de línea de caché. */
+    static const int ENTEROS_POR_LINEA = ALINEACION_BYTES / sizeof(int);
+    static const std::size_t BYTES_PAGINA = 4096;                    /**< Página normal. */
+    static const std::size_t BYTES_PAGINA_GRANDE = 2 << 20;          /**< Página grande (huge page) x86-64. */
+
+    MatrizDP();
+
+    /**
+     * @brief Reserva una matriz filas x columnas inicializada a cero.
+     * @param filas Número de filas (m + 1).
+     * @param columnas Número de columnas (n + 1).
+     * @param disposicion Disposición en memoria (filas, bloques o diagonales).
+     * @param tam_bloque Lado de la tesela en disposición por bloques (se redondea
+     *        a potencia de 2, mínimo ENTEROS_POR_LINEA). Se ignora en disposición por filas.
+     */
+    MatrizDP(int filas, int columnas,
+             DisposicionMatriz disposicion = DISPOSICION_FILAS,
+             int tam_bloque = 64);
+
+    ~MatrizDP();
+
+    /**
+     * @brief Cambia dimensiones y disposición conservando el buffer si es suficiente.
+     *
+     * Solo reserva cuando la nueva matriz no cabe en lo ya reservado (el
+     * buffer nunca encoge). Las celdas quedan sin inicializar: el llamador
+     * debe escribir cada celda antes de leerla, como hacen los motores NW.
+     *
+     * @param paginas_grandes Si hay que reservar, con reservarPaginasGrandes;
+     *        con false, alineado a página normal, para que cada página (y su
+     *        nodo NUMA) sea de una sola tesela y no de las 32 o 128 que caben
+     *        en una página grande.
+     * @return true si ha reservado un buffer nuevo: sus páginas aún no se han
+     *         tocado, así que el primer thread que escriba cada una decide en
+     *         qué nodo NUMA queda.
+     */
+    bool redimensionar(int filas, int columnas,
+                       DisposicionMatriz disposicion = DISPOSICION_FILAS,
+                       int tam_bloque = 64,
+                       bool paginas_grandes = true);
+
+    MatrizDP(MatrizDP&& otra);
+    MatrizDP& operator=(MatrizDP&& otra);
+
+    MatrizDP(const MatrizDP&) = delete;
+    MatrizDP& operator=(const MatrizDP&) = delete;
+
+    int filas() const { return filas_; }
+    int columnas() const { return columnas_; }
+    /** @brief Distancia en enteros entre filas consecutivas (solo disposición por filas). */
+    std::size_t stride() const { return stride_; }
+    DisposicionMatriz disposicion() const { return disposicion_; }
+    /** @brief Lado de la tesela (solo disposición por bloques). */
+    int tamBloque() const { return 1 << log_bloque_; }
+
+    /** @brief Posición lineal de la celda (i, j) dentro del buffer. */
+    std::size_t indice(int i, int j) const {
+        if (disposicion_ == DISPOSICION_FILAS) {
+            return static_cast<std::size_t>(i) * stride_ + j;
+        }
+        if (disposicion_ == DISPOSICION_DIAGONALES) {
+            int d = i + j;
+            return inicio_diagonal_[d] + (i - primeraFilaDiagonal(d));
+        }
+        std::size_t tesela = static_cast<std::size_t>(i >> log_bloque_) * bloques_j_ + (j >> log_bloque_);
+        return (tesela << (2 * log_bloque_))
+             + (static_cast<std::size_t>(i & mascara_bloque_) << log_bloque_)
+             + (j & mascara_bloque_);
+    }
+
+    int& operator()(int i, int j) { return datos_[indice(i, j)]; }
+    const int& operator()(int i, int j) const { return datos_[indice(i, j)]; }
+
+    /**
+     * @brief Puntero al inicio de la fila i (solo disposición por filas).
+     *
+     * En disposición por bloques las celdas (i, j) son contiguas en j únicamente
+     * dentro de una misma tesela; usar &(*this)(i, j) al inicio de cada tesela.
+     */
+    int* fila(int i) { return datos_ + static_cast<std::size_t>(i) * stride_; }
+    const int* fila(int i) const { return datos_ + static_cast<std::size_t>(i) * stride_; }
+
+    /**
+     * @brief Puntero a la tesela (bi, bj), tamBloque()² enteros contiguos
+     *        (solo disposición por bloques).
+     */
+    int* tesela(int bi, int bj) {
+        return datos_ + ((static_cast<std::size_t>(bi) * bloques_j_ + bj) << (2 * log_bloque_));
+    }
+
+    /** @brief Menor fila i presente en la antidiagonal d (i + j = d). */
+    int primeraFilaDiagonal(int d) const {
+        return (d - (columnas_ - 1) > 0) ? d - (columnas_ - 1) : 0;
+    }
+
+    /**
+     * @brief Puntero a la celda (primeraFilaDiagonal(d), d - primeraFilaDiagonal(d))
+     *        (solo disposición por diagonales). Las celdas siguientes de la
+     *        diagonal son las de i creciente.
+     */
+    int* diagonal(int d) { return datos_ + inicio_diagonal_[d]; }
+    const int* diagonal(int d) const { return datos_ + inicio_diagonal_[d]; }
+
+    /** @brief Acceso directo al buffer subyacente. */
+    int* datos() { return datos_; }
+    const int* datos() const { return datos_; }
+
+    /** @brief Número de enteros que ocupa la matriz actual (incluye relleno). */
+    std::size_t capacidad() const { return capacidad_; }
+
+    /** @brief Número de enteros reservados (>= capacidad(), tras redimensionar a menos). */
+    std::size_t reservado() const { return reservado_; }
+
+    /** @brief Asigna el mismo valor a todas las celdas (incluido relleno). */
+    void llenar(int valor);
+
+private:
+    void liberar();
+
+    int* datos_;
+    std::size_t capacidad_;
+    std::size_t reservado_;
+    int filas_;
+    int columnas_;
+    std::size_t stride_;
+    DisposicionMatriz disposicion_;
+    int log_bloque_;
+    int mascara_bloque_;
+    std::size_t bloques_j_;
+    std::vector<std::size_t> inicio_diagonal_;
+};
+
+/**
+ * @brief Reserva memoria alineada (liberar con liberarAlineado).
+ * @param alineacion Alineación en bytes (potencia de 2).
+ * @param bytes Tamaño solicitado.
+ * @return void* Puntero alineado, o nullptr si falla la reserva.
+ */
+void* reservarAlineado(std::size_t alineacion, std::size_t bytes);
+
+/**
+ * @brief Reserva memoria para una matriz grande, con páginas grandes si el sistema las da.
+ *
+ * En Linux, a partir de BYTES_PAGINA_GRANDE alinea el buffer a página grande
+ * y lo marca con madvise(MADV_HUGEPAGE): con las transparent huge pages en
+ * modo "madvise" o "always" el núcleo lo respalda con páginas de 2 MB, lo
+ * que reduce los fallos de TLB al recorrer matrices de cientos de MB. En
+ * otro caso equivale a reservarAlineado(MatrizDP::ALINEACION_BYTES, bytes).
+ * Las páginas no se tocan: siguen sin nodo NUMA hasta la primera escritura.
+ * Se libera con liberarAlineado.
+ */
+void* reservarPaginasGrandes(std::size_t bytes);
+
+/**
+ * @brief Libera memoria obtenida con reservarAlineado o reservarPaginasGrandes.
+ */
+void liberarAlineado(void* puntero);
+
+#endif // MATRIZ_DP_H
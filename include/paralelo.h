@@ -3,6 +3,7 @@
 
 #include <string>
 #include "tipos.h"
+#include "espacio_trabajo.h"
 
 /**
  * @file paralelo.h
@@ -34,6 +35,9 @@
  * Solo paraleliza la fase 2 (llenado de matriz). La fase 1 (inicialización)
  * y fase 3 (traceback) se ejecutan secuencialmente.
  *
+ * Con config.xdrop > 0 cada antidiagonal se limita al tramo que puede tener
+ * predecesores vivos y se aplica la poda X-drop/Z-drop de poda.h.
+ *
  * @param secA Secuencia A (DNA) a alinear.
  * @param secB Secuencia B (DNA) a alinear.
  * @param config Configuración de alineamiento (puntuación, verbose, etc.).
@@ -60,6 +64,15 @@ ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
  * Solo paraleliza la fase 2 (llenado de matriz). La fase 1 (inicialización)
  * y fase 3 (traceback) se ejecutan secuencialmente.
  *
+ * Con varios threads fijados a lugares (OMP_PLACES y OMP_PROC_BIND) cada
+ * fila de teselas tiene un thread dueño fijo: la primera escritura de una
+ * matriz recién reservada y el llenado siguen ese reparto, así que en un
+ * sistema NUMA cada tesela queda en el nodo de quien la calcula. En ese
+ * caso OMP_SCHEDULE no se utiliza y la matriz usa páginas normales (una
+ * página grande mezclaría teselas de varios dueños). Sin threads fijados,
+ * la fase 2 usa schedule(runtime) y la matriz, páginas grandes si el
+ * sistema las da.
+ *
  * @param secA Secuencia A (DNA) a alinear.
  * @param secB Secuencia B (DNA) a alinear.
  * @param config Configuración de alineamiento (puntuación, verbose, etc.).
@@ -71,5 +84,230 @@ ResultadoAlineamiento alineamientoNWParaleloBloques(
     const ConfiguracionAlineamiento& config
 );
 
+/**
+ * @brief Ejecuta Needleman–Wunsch por antidiagonales con almacenamiento sesgado y SIMD.
+ *
+ * Variante de alineamientoNWParaleloAntidiagonal en la que la matriz se guarda
+ * en disposición por diagonales (MatrizDP con DISPOSICION_DIAGONALES): las
+ * celdas de la antidiagonal k son contiguas por i, y sus tres dependencias
+ * están en posiciones consecutivas de las antidiagonales k-1 y k-2. Las
+ * secuencias se codifican (IUPAC) una sola vez, y B se invierte para que
+ * secB[k-i-1] también avance con i. Así el trozo de cada thread se procesa con
+ * "omp for simd": paralelismo de threads y de vector sobre el mismo frente.
+ *
+ * Solo paraleliza la fase 2 (llenado de matriz). La fase 1 (inicialización)
+ * y fase 3 (traceback) se ejecutan secuencialmente.
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalSIMD(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Ejecuta Needleman–Wunsch por antidiagonales dentro de una única región paralela.
+ *
+ * Las variantes -a y -v abren un "omp parallel for" por antidiagonal (m+n-1
+ * ciclos fork/join; unos 64k para 32k x 32k). Aquí el equipo de threads se crea
+ * una sola vez para toda la fase 2: cada thread calcula por sí mismo su tramo
+ * estático de la antidiagonal (reparto equilibrado por índice i, sin
+ * planificador) y los threads solo se sincronizan con una barrera entre
+ * antidiagonales. Las antidiagonales cortas (inicio y final de la matriz) se
+ * reparten entre menos threads para no trocearlas en tramos diminutos.
+ *
+ * Usa el mismo almacenamiento sesgado y el mismo kernel "omp simd" que
+ * alineamientoNWParaleloAntidiagonalSIMD, de modo que la diferencia entre
+ * ambas mide el coste de crear el equipo en cada antidiagonal.
+ * OMP_SCHEDULE no se utiliza.
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalPersistente(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Ejecuta Needleman–Wunsch por bloques con tareas OpenMP dirigidas por dependencias.
+ *
+ * Usa las mismas teselas que alineamientoNWParaleloBloques, pero en lugar de
+ * recorrer las antidiagonales de bloques con un "omp parallel for" (y su
+ * barrera implícita) cada tesela es una tarea con depend sobre sus vecinas
+ * norte, oeste y noroeste. Una tesela arranca en cuanto sus entradas están
+ * listas, sin esperar a la más lenta de su antidiagonal.
+ * OMP_SCHEDULE no se utiliza.
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWParaleloTareas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Ejecuta Needleman–Wunsch por franjas de columnas en tubería (pipeline).
+ *
+ * Cada thread es dueño de una franja vertical fija de columnas (límites
+ * alineados a línea de caché) y la recorre de arriba abajo. El avance se
+ * publica en un contador de filas por franja, relleno a línea de caché, sobre
+ * el que espera activamente solo el vecino derecho. No hay barreras globales
+ * ni sincronización por antidiagonal: en régimen estacionario todos los
+ * threads calculan a la vez, desfasados una fila. Requiere que los threads
+ * no estén sobresuscritos (OMP_NUM_THREADS <= núcleos) para rendir bien.
+ * OMP_SCHEDULE no se utiliza.
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWParaleloFranjas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/*
+ * Versiones con EspacioTrabajo: mismo resultado, pero la matriz, las
+ * secuencias codificadas, el perfil y los buffers auxiliares se toman del
+ * espacio del llamador en lugar de reservarse en cada llamada. Pensadas para
+ * alinear muchos pares (o repetir uno) con el mismo espacio; el espacio no
+ * se puede compartir entre dos alineamientos simultáneos. La poda X-drop de
+ * la variante antidiagonal no usa el espacio.
+ */
+
+/** @brief alineamientoNWParaleloAntidiagonal con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief alineamientoNWParaleloBloques con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloBloques(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief alineamientoNWParaleloAntidiagonalSIMD con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalSIMD(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief alineamientoNWParaleloAntidiagonalPersistente con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalPersistente(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief alineamientoNWParaleloTareas con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloTareas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief alineamientoNWParaleloFranjas con la memoria de espacio (también sus contadores). */
+ResultadoAlineamiento alineamientoNWParaleloFranjas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/**
+ * @brief Needleman–Wunsch con gap afín (Gotoh) por bloques.
+ *
+ * Misma estrategia que la variante por bloques con matriz de direcciones:
+ * antidiagonales de teselas repartidas con "omp parallel for" y solo
+ * fronteras rodantes (H y F por columna, H y E por fila, esquinas). Cada
+ * celda guarda un byte de estado (MatrizEstadosAfin) y el traceback es
+ * tracebackAfin. Usa config.puntuacion.parametros.apertura.
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWParaleloAfinBloques(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Needleman–Wunsch con gap afín (Gotoh) por antidiagonales, región única y SIMD.
+ *
+ * Como alineamientoNWParaleloAntidiagonalPersistente: un equipo para toda la
+ * fase 2, reparto estático y una barrera por antidiagonal. H se guarda en
+ * tres antidiagonales rodantes y E/F en dos, indexadas por fila, de modo que
+ * las cinco dependencias de una celda son cargas consecutivas y el tramo de
+ * cada thread se vectoriza con "omp simd". Los bytes de estado se guardan en
+ * disposición por diagonales.
+ * OMP_SCHEDULE no se utiliza.
+ *
+ * @param secA Secuencia A (DNA) a alinear.
+ * @param secB Secuencia B (DNA) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene puntuación y tiempos instrumentados.
+ */
+ResultadoAlineamiento alineamientoNWParaleloAfinAntidiagonal(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/** @brief alineamientoNWParaleloAfinBloques con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloAfinBloques(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/** @brief alineamientoNWParaleloAfinAntidiagonal con la memoria de espacio. */
+ResultadoAlineamiento alineamientoNWParaleloAfinAntidiagonal(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/**
+ * @brief Describe la colocación de threads de OpenMP (OMP_PLACES / OMP_PROC_BIND).
+ *
+ * El reparto de teselas de alineamientoNWParaleloBloques (y su primera
+ * escritura) sigue a los threads, y estos a los lugares: con OMP_PLACES
+ * definido y los threads fijados, cada tesela vive en el nodo NUMA del
+ * lugar de su thread.
+ *
+ * @return "places=<número de lugares>/<política de OMP_PROC_BIND>", p. ej.
+ *         "places=8/spread"; cadena vacía si no hay lugares definidos, los
+ *         threads no están fijados o el runtime no lo soporta (OpenMP < 4.5).
+ */
+std::string describirLugaresOpenMP();
+
 #endif // PARALELO_H
 
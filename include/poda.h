@@ -0,0 +1,126 @@
+#ifndef PODA_H
+#define PODA_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "tipos.h"
+#include "matriz_dp.h"
+
+/**
+ * @file poda.h
+ * @brief Poda X-drop / Z-drop para los motores NW secuencial y antidiagonal (DNA).
+ *
+ * Con config.xdrop > 0 una celda cuya puntuación queda más de xdrop por
+ * debajo de la mejor vista en las filas (o antidiagonales) anteriores se
+ * trata como -infinito y no se extiende. Cada línea guarda solo el intervalo
+ * entre su primera y su última celda viva, así que un par no relacionado
+ * se abandona tras recorrer una franja cercana a (0, 0) en lugar de m x n
+ * celdas. El resultado es heurístico: coincide con NW si el camino óptimo
+ * nunca cae por debajo del umbral.
+ */
+
+/** @brief -infinito de las celdas podadas o fuera de su línea (margen para sumar penalidades). */
+const int PODA_MENOS_INFINITO = -(1 << 29);
+
+/**
+ * @brief Umbral de poda respecto a la mejor celda vista.
+ *
+ * X-drop: se poda si valor < mejor - xdrop. Z-drop (como en minimap2) añade
+ * |gap| por cada diagonal que separa la celda de la mejor, de modo que un
+ * gap largo no se corta solo por su longitud.
+ */
+struct CriterioPoda {
+    int xdrop;
+    int pendiente;    /**< |gap| con Z-drop, 0 con X-drop. */
+    int mejor;        /**< Mejor puntuación vista hasta la línea anterior. */
+    int diag_mejor;   /**< Diagonal j - i de esa celda. */
+
+    CriterioPoda(const ConfiguracionAlineamiento& config, int penalidadGap)
+        : xdrop(config.xdrop), pendiente(config.zdrop ? -penalidadGap : 0),
+          mejor(0), diag_mejor(0) {}
+
+    bool podar(int valor, int diagonal) const {
+        int desvio = (diagonal >= diag_mejor) ? diagonal - diag_mejor : diag_mejor - diagonal;
+        return valor < mejor - xdrop - pendiente * desvio;
+    }
+};
+
+/**
+ * @brief Matriz DP dispersa: por cada línea (fila i o antidiagonal i + j)
+ *        solo el intervalo de posiciones con celdas vivas.
+ *
+ * La posición dentro de la línea es j por filas e i por antidiagonales. Las
+ * líneas se añaden en orden y se guardan contiguas en un único buffer, de
+ * modo que la memoria es proporcional a las celdas conservadas.
+ */
+class MatrizPodada {
+public:
+    /** @param disposicion DISPOSICION_FILAS o DISPOSICION_DIAGONALES. */
+    explicit MatrizPodada(DisposicionMatriz disposicion) : disposicion_(disposicion) {}
+
+    /**
+     * @brief Añade la siguiente línea con posiciones [primera, ultima].
+     * @return Puntero a sus ultima - primera + 1 celdas (válido hasta el próximo anadirLinea).
+     */
+    int* anadirLinea(int primera, int ultima);
+
+    /** @brief Última línea añadida vacía (sin celdas vivas). */
+    void anadirLineaVacia() { anadirLinea(0, -1); }
+
+    int lineas() const { return static_cast<int>(primera_.size()); }
+    int primera(int l) const { return primera_[l]; }
+    int ultima(int l) const { return ultima_[l]; }
+    /** @brief Celdas de la línea l, empezando por la posición primera(l). */
+    const int* linea(int l) const { return datos_.data() + inicio_[l]; }
+
+    /** @brief F(i, j), o PODA_MENOS_INFINITO si la celda no se conservó. */
+    int valor(int i, int j) const {
+        int l = (disposicion_ == DISPOSICION_FILAS) ? i : i + j;
+        int posicion = (disposicion_ == DISPOSICION_FILAS) ? j : i;
+        if (i < 0 || j < 0 || l >= lineas()
+            || posicion < primera_[l] || posicion > ultima_[l]) {
+            return PODA_MENOS_INFINITO;
+        }
+        return datos_[inicio_[l] + (posicion - primera_[l])];
+    }
+
+    std::size_t celdas() const { return datos_.size(); }
+
+private:
+    DisposicionMatriz disposicion_;
+    std::vector<int> datos_;
+    std::vector<std::size_t> inicio_;
+    std::vector<int> primera_;
+    std::vector<int> ultima_;
+};
+
+/**
+ * @brief Traceback por recálculo sobre una MatrizPodada desde (i, j).
+ *
+ * Misma prioridad ante empates que tracebackMatrizDP. Si (i, j) no es
+ * (m, n) el alineamiento cubre solo los prefijos A[0, i) y B[0, j).
+ *
+ * @param F Matriz ya llena.
+ * @param i Fila de partida.
+ * @param j Columna de partida.
+ * @param codA A codificada (codificarIUPAC).
+ * @param codB B codificada.
+ * @param tabla Tabla de sustitución del esquema.
+ * @param penalidadGap Penalidad por gap.
+ * @param secA Secuencia A original.
+ * @param secB Secuencia B original.
+ * @param config Configuración (salida_cigar).
+ * @param alineadaA Salida: A con gaps (vacía en modo CIGAR).
+ * @param alineadaB Salida: B con gaps (vacía en modo CIGAR).
+ * @param cigar Salida: CIGAR (vacío si no se pidió).
+ */
+void tracebackPodado(const MatrizPodada& F, int i, int j,
+                     const std::string& codA, const std::string& codB,
+                     const TablaSustitucionDNA& tabla, int penalidadGap,
+                     const std::string& secA, const std::string& secB,
+                     const ConfiguracionAlineamiento& config,
+                     std::string& alineadaA, std::string& alineadaB,
+                     std::string& cigar);
+
+#endif // PODA_H
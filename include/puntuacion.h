@@ -2,43 +2,200 @@
 #define PUNTUACION_H
 
 #include <string>
+#include <vector>
+
+class SecuenciaDNA;
+
+/**
+ * @brief Tamaño del alfabeto de códigos IUPAC: un bit por base posible
+ *        (A = 1, C = 2, G = 4, T/U = 8), de modo que R = A|G, N = 15, etc.
+ *        El código 0 agrupa los símbolos fuera del alfabeto.
+ */
+const int TAM_ALFABETO_IUPAC = 16;
 
 /**
  * @brief Esquema simple de puntuación para DNA: coincidencia, sustitución y gap.
+ *
+ * Un gap de longitud k puntúa apertura + k·gap. Con apertura = 0 el gap es
+ * lineal (el caso de todos los motores salvo los afines, que son los únicos
+ * que leen apertura).
  */
 struct EsquemaPuntuacionDNA {
     int coincidencia;   /**< Puntuación por coincidencia (match). */
     int sustitucion;    /**< Puntuación por sustitución (mismatch). */
-    int gap;            /**< Penalidad por gap. */
+    int gap;            /**< Penalidad por base de gap (extensión). */
+    int apertura;       /**< Penalidad adicional por abrir un gap (0 = gap lineal). */
     
-    EsquemaPuntuacionDNA(int coin = 2, int sust = -1, int g = -2) 
-        : coincidencia(coin), sustitucion(sust), gap(g) {}
+    EsquemaPuntuacionDNA(int coin = 2, int sust = -1, int g = -2, int ap = 0) 
+        : coincidencia(coin), sustitucion(sust), gap(g), apertura(ap) {}
 };
 
 /**
  * @brief Configuración de puntuación para DNA.
  *
- * Usa esquema simple: coincidencia, sustitución y gap.
+ * Usa esquema simple: coincidencia, sustitución y gap. Los símbolos se
+ * puntúan por su código IUPAC (sin distinguir mayúsculas, U = T); un
+ * símbolo fuera del alfabeto nunca coincide.
  */
 struct ConfiguracionPuntuacionDNA {
     EsquemaPuntuacionDNA parametros;  /**< Parámetros de puntuación. */
+    /**
+     * Si es true, los códigos ambiguos puntúan la media (redondeada) sobre las
+     * bases que representan: A/R = (coincidencia + sustitución) / 2,
+     * A/N = (coincidencia + 3·sustitución) / 4. Si es false solo coinciden
+     * códigos idénticos (N con N, R con R).
+     */
+    bool iupac;
     
     ConfiguracionPuntuacionDNA() 
-        : parametros(2, -1, -2) {}  // match=2, mismatch=-1, gap=-2 por defecto
+        : parametros(2, -1, -2), iupac(false) {}  // match=2, mismatch=-1, gap=-2 por defecto
+    
+    ConfiguracionPuntuacionDNA(int coincidencia, int sustitucion, int gap, int apertura = 0)
+        : parametros(coincidencia, sustitucion, gap, apertura), iupac(false) {}
+    
+    /** @brief true si el esquema tiene penalidad de apertura (gap afín, Gotoh). */
+    bool gapAfin() const { return parametros.apertura != 0; }
     
-    ConfiguracionPuntuacionDNA(int coincidencia, int sustitucion, int gap)
-        : parametros(coincidencia, sustitucion, gap) {}
+    /**
+     * @brief Puntuación entre dos códigos IUPAC (0..TAM_ALFABETO_IUPAC-1).
+     *
+     * Fuera de los bucles internos; los motores consultan TablaSustitucionDNA.
+     */
+    int puntuacionCodigos(unsigned char a, unsigned char b) const;
+    
+    /**
+     * @brief Indica si el esquema equivale a distancia de edición unitaria.
+     *
+     * Con coincidencia M, sustitución X y gap G, todo alineamiento global de
+     * secuencias de longitudes m y n puntúa
+     *   M(m+n)/2 - (M - X)·sustituciones - (M/2 - G)·gaps,
+     * de modo que si M - X = M/2 - G > 0 (2X - M = 2G y X < M) maximizar la
+     * puntuación equivale a minimizar la distancia de Levenshtein.
+     * Por ejemplo 0/-1/-1 y 2/-1/-2. Con puntuación IUPAC ambigua nunca lo es.
+     */
+    bool equivalenteDistanciaEdicion() const {
+        return !iupac && !gapAfin()
+            && parametros.sustitucion < parametros.coincidencia
+            && 2 * parametros.sustitucion - parametros.coincidencia == 2 * parametros.gap;
+    }
+    
+    /**
+     * @brief Puntuación óptima NW a partir de la distancia de edición
+     *        (solo válido si equivalenteDistanciaEdicion()).
+     */
+    int puntuacionDesdeDistancia(int distancia, int m, int n) const {
+        return (parametros.coincidencia * (m + n)
+                - 2 * (parametros.coincidencia - parametros.sustitucion) * distancia) / 2;
+    }
+};
+
+/**
+ * @brief Tabla de sustitución 16 x 16 sobre códigos IUPAC.
+ *
+ * Los motores la construyen una vez por alineamiento (1 KB, cabe en L1) y
+ * en el bucle interno hacen una sola carga indexada por celda.
+ */
+struct TablaSustitucionDNA {
+    int valores[TAM_ALFABETO_IUPAC * TAM_ALFABETO_IUPAC];  /**< valores[a * 16 + b]. */
+
+    explicit TablaSustitucionDNA(const ConfiguracionPuntuacionDNA& config);
+
+    /** @brief Puntuaciones de a frente a cada código b. */
+    const int* fila(unsigned char a) const { return valores + a * TAM_ALFABETO_IUPAC; }
+
+    int operator()(unsigned char a, unsigned char b) const {
+        return valores[a * TAM_ALFABETO_IUPAC + b];
+    }
 };
 
 /**
  * @brief Obtiene la puntuación entre dos bases DNA según la configuración.
- * @param a Primera base (A, T, G, C).
- * @param b Segunda base (A, T, G, C).
+ *
+ * Para usos puntuales (traceback, verificación); los bucles de llenado usan
+ * TablaSustitucionDNA o un perfil de consulta.
+ *
+ * @param a Primera base (símbolo IUPAC, sin distinguir mayúsculas).
+ * @param b Segunda base (símbolo IUPAC, sin distinguir mayúsculas).
  * @param config Configuración de puntuación.
- * @return int Puntuación asignada (coincidencia o sustitución).
+ * @return int Puntuación asignada.
  */
 int obtenerPuntuacionDNA(char a, char b, const ConfiguracionPuntuacionDNA& config);
 
+/**
+ * @brief Código IUPAC de 4 bits de un símbolo (0 si no pertenece al alfabeto).
+ */
+unsigned char codigoIUPAC(char c);
+
+/**
+ * @brief Secuencia traducida a códigos IUPAC (un byte 0..15 por base).
+ *
+ * Los motores la calculan una vez en la fase 1 para indexar la tabla de
+ * sustitución o el perfil de consulta sin normalizar por celda.
+ *
+ * @param secuencia Secuencia DNA original.
+ * @return std::string Códigos de la secuencia.
+ */
+std::string codificarIUPAC(const std::string& secuencia);
+
+/**
+ * @brief Igual que codificarIUPAC, pero escribe en un buffer existente
+ *        (reutiliza su capacidad entre llamadas).
+ */
+void codificarIUPAC(const std::string& secuencia, std::string& codigos);
+
+/**
+ * @brief codificarIUPAC de una secuencia empaquetada, sin pasar por el texto.
+ *
+ * Cada base de 2 bits se traduce directamente a su código (A = 1, C = 2,
+ * G = 4, T = 8) y después se reponen las excepciones.
+ */
+void codificarIUPAC(const SecuenciaDNA& secuencia, std::string& codigos);
+
+/**
+ * @brief Perfil de consulta de B: una fila de puntuaciones por código IUPAC.
+ *
+ * perfil[c * n + j] = tabla(c, codigosB[j]). Un motor que recorre la fila i
+ * toma la fila del código de A[i-1] y hace una sola carga contigua por
+ * celda. Ocupa 16·n enteros.
+ *
+ * @param codigosB Secuencia B ya codificada (codificarIUPAC).
+ * @param tabla Tabla de sustitución.
+ * @return std::vector<int> Perfil de TAM_ALFABETO_IUPAC x n puntuaciones.
+ */
+std::vector<int> construirPerfilConsulta(const std::string& codigosB, const TablaSustitucionDNA& tabla);
+
+/**
+ * @brief Igual que construirPerfilConsulta, pero escribe en un buffer existente.
+ */
+void construirPerfilConsulta(const std::string& codigosB, const TablaSustitucionDNA& tabla,
+                             std::vector<int>& perfil);
+
+/**
+ * @brief Esquemas con kernel de llenado especializado en tiempo de compilación.
+ *
+ * Con un esquema fijo el compilador pliega gap, coincidencia y sustitución
+ * como constantes y la sustitución se resuelve comparando códigos, sin
+ * perfil de consulta. Solo aplican sin modo iupac.
+ */
+enum EsquemaFijoDNA {
+    ESQUEMA_GENERICO,   /**< Cualquier otro esquema: perfil de consulta en tiempo de ejecución. */
+    ESQUEMA_2_M1_M2,    /**< match 2, mismatch -1, gap -2 (el de producción). */
+    ESQUEMA_1_M1_M2,    /**< match 1, mismatch -1, gap -2. */
+    ESQUEMA_1_M1_M1,    /**< match 1, mismatch -1, gap -1. */
+    ESQUEMA_0_M1_M1     /**< Distancia de edición con signo: 0, -1, -1. */
+};
+
+/**
+ * @brief Identifica si la configuración coincide con un esquema especializado.
+ * @return EsquemaFijoDNA ESQUEMA_GENERICO si no hay kernel para ella.
+ */
+EsquemaFijoDNA detectarEsquemaFijo(const ConfiguracionPuntuacionDNA& config);
+
+/**
+ * @brief Nombre legible de un esquema fijo ("2/-1/-2", ..., "generico").
+ */
+const char* nombreEsquemaFijo(EsquemaFijoDNA esquema);
+
 /**
  * @brief Extrae la penalidad de gap de una configuración de puntuación.
  * @param config Configuración de puntuación.
@@ -0,0 +1,113 @@
+#ifndef SECUENCIA_DNA_H
+#define SECUENCIA_DNA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file secuencia_dna.h
+ * @brief Secuencia DNA empaquetada a 2 bits por base.
+ *
+ * A, C, G y T (en cualquier caja) ocupan 2 bits; cualquier otro símbolo (N,
+ * códigos IUPAC, ...) se marca en una máscara de 1 bit por base y se guarda
+ * aparte. Para 32k bases son ~8 KB + 4 KB de máscara frente a 32 KB de
+ * std::string.
+ */
+
+/**
+ * @brief Secuencia DNA con 32 bases por palabra de 64 bits.
+ *
+ * La base i ocupa los bits 2·(i % 32) y 2·(i % 32) + 1 de la palabra i / 32
+ * (A = 0, C = 1, G = 2, T = 3). Las posiciones con bit a 1 en la máscara no
+ * son ACGT: su código de 2 bits vale 0 y el símbolo real (en mayúscula) está
+ * en la lista de excepciones, ordenada por posición.
+ *
+ * La secuencia se normaliza al construirla (mayúsculas); la puntuación no
+ * cambia, porque obtenerPuntuacionDNA no distingue mayúsculas.
+ */
+class SecuenciaDNA {
+public:
+    SecuenciaDNA() : longitud_(0) {}
+
+    /** @brief Empaqueta una secuencia ya cargada en memoria. */
+    explicit SecuenciaDNA(const std::string& secuencia);
+
+    /**
+     * @brief Secuencia a partir de sus palabras de 2 bits ya empaquetadas.
+     *
+     * Las posiciones que no son ACGT deben valer 0 y marcarse después con
+     * marcarExcepciones.
+     */
+    SecuenciaDNA(const std::uint64_t* palabras, std::size_t longitud);
+
+    /** @brief Añade bases al final (p. ej. una línea de un FASTA). */
+    void anadir(const char* datos, std::size_t longitud);
+    void anadir(const std::string& datos) { anadir(datos.data(), datos.size()); }
+
+    /**
+     * @brief Marca [inicio, inicio + longitud) como excepciones con el símbolo dado.
+     *
+     * Los tramos deben llegar en orden de posición y sin solaparse.
+     */
+    void marcarExcepciones(std::size_t inicio, std::size_t longitud, char simbolo);
+
+    /** @brief Reserva espacio para al menos 'bases' bases. */
+    void reservar(std::size_t bases);
+
+    std::size_t longitud() const { return longitud_; }
+    bool vacia() const { return longitud_ == 0; }
+
+    /** @brief Símbolo (en mayúscula) de la base i. */
+    char base(std::size_t i) const;
+
+    /** @brief true si la base i no es A, C, G ni T. */
+    bool esExcepcion(std::size_t i) const {
+        return (mascara_[i >> 6] >> (i & 63)) & 1;
+    }
+
+    /**
+     * @brief Palabra k: bases 32k..32k+31 a 2 bits (las posiciones de relleno valen 0).
+     *
+     * Permite comparar 32 bases con un XOR; las excepciones deben filtrarse
+     * con palabraMascara.
+     */
+    std::uint64_t palabra(std::size_t k) const { return palabras_[k]; }
+
+    /** @brief Bits de máscara de las bases 32k..32k+31 (uno por base, en los bits pares). */
+    std::uint64_t palabraMascara(std::size_t k) const;
+
+    std::size_t palabras() const { return palabras_.size(); }
+    std::size_t numeroExcepciones() const { return excepciones_.size(); }
+
+    /** @brief Excepciones (posición, símbolo), ordenadas por posición. */
+    const std::vector<std::pair<std::size_t, char> >& excepciones() const { return excepciones_; }
+
+    /**
+     * @brief Secuencia en mayúsculas, lista para pasar a los motores.
+     *
+     * Decodifica palabra a palabra y después repone las excepciones.
+     */
+    std::string desempaquetar() const;
+
+    /** @brief Bytes ocupados por bases, máscara y excepciones. */
+    std::size_t bytes() const;
+
+private:
+    std::vector<std::uint64_t> palabras_;
+    std::vector<std::uint64_t> mascara_;
+    std::vector<std::pair<std::size_t, char> > excepciones_;
+    std::size_t longitud_;
+};
+
+/**
+ * @brief Número de posiciones i < min(|a|, |b|) con la misma base en a y b.
+ *
+ * Compara 32 bases por operación (XOR y popcount); solo las palabras con
+ * excepciones se resuelven base a base.
+ */
+std::size_t contarCoincidenciasPosicionales(const SecuenciaDNA& a, const SecuenciaDNA& b);
+
+#endif // SECUENCIA_DNA_H
@@ -2,7 +2,9 @@
 #define SECUENCIAL_H
 
 #include <string>
+#include <vector>
 #include "tipos.h"
+#include "espacio_trabajo.h"
 
 /**
  * @file secuencial.h
@@ -16,6 +18,19 @@
  * las decisiones de traceback consultando la matriz de puntuaciones. Reduce memoria
  * a costa de algún coste adicional de CPU durante el traceback.
  *
+ * Con config.traceback_direcciones = true hace lo contrario: guarda una
+ * MatrizDirecciones de 2 bits por celda y solo dos filas de puntuación, y el
+ * traceback se limita a seguir punteros (mismo alineamiento).
+ *
+ * Si detectarEsquemaFijo reconoce el esquema (p. ej. 2/-1/-2) la fase 2 usa
+ * un kernel de fila con las puntuaciones como constantes de compilación; si
+ * no, el genérico con perfil de consulta.
+ *
+ * Con config.xdrop > 0 aplica la poda X-drop/Z-drop de poda.h (tiene
+ * prioridad sobre traceback_direcciones): cada fila solo cubre el tramo vivo
+ * y, si el llenado se corta antes de (m, n), el resultado queda marcado
+ * como truncado.
+ *
  * @param secA Secuencia A (string) a alinear.
  * @param secB Secuencia B (string) a alinear.
  * @param config Configuración de alineamiento (puntuación, verbose, etc.).
@@ -27,5 +42,73 @@ ResultadoAlineamiento AlgNW(
     const ConfiguracionAlineamiento& config
 );
 
+/**
+ * @brief AlgNW con la matriz y los buffers de un EspacioTrabajo (mismo resultado).
+ *
+ * La poda X-drop (config.xdrop > 0) sigue reservando su MatrizPodada.
+ */
+ResultadoAlineamiento AlgNW(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/**
+ * @brief Calcula solo la puntuación óptima de Needleman–Wunsch (sin alineamiento).
+ *
+ * Mantiene únicamente dos filas de la matriz DP (O(n) memoria), no reserva la
+ * matriz cuadrática y omite la fase 3. El resultado tiene secA/secB vacías,
+ * solo_puntuacion = true y tiempo_fase3_ms = 0; la fase 2 es directamente
+ * comparable con la fase 2 de AlgNW (mismo kernel de fila).
+ *
+ * @param secA Secuencia A (string) a alinear.
+ * @param secB Secuencia B (string) a alinear.
+ * @param config Configuración de alineamiento (puntuación, verbose, etc.).
+ * @return ResultadoAlineamiento Contiene la puntuación y los tiempos de las fases 1 y 2.
+ */
+ResultadoAlineamiento puntuacionNW(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief puntuacionNW con los buffers de un EspacioTrabajo (mismo resultado).
+ *
+ * Alineando muchos pares con un mismo espacio (p. ej. uno por thread en
+ * alinearLote) la fase 1 deja de reservar memoria en cuanto los buffers
+ * alcanzan el par más largo.
+ */
+ResultadoAlineamiento puntuacionNW(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
+/**
+ * @brief Núcleo de puntuacionNW sobre secuencias ya codificadas.
+ *
+ * Para quien compara una misma B contra muchas A (todos contra todos,
+ * búsqueda en una base de datos): codifica una vez y construye el perfil de
+ * B una sola vez. Solo usa las filas anterior y actual de espacio.
+ *
+ * @param codA A codificada (codificarIUPAC).
+ * @param codB B codificada.
+ * @param perfil Perfil de consulta de codB; solo se lee si detectarEsquemaFijo
+ *        devuelve ESQUEMA_GENERICO (si no puede estar vacío).
+ * @param config Configuración de alineamiento.
+ * @param espacio Filas de trabajo (crecen si hace falta).
+ * @return Puntuación NW óptima.
+ */
+int puntuacionNWCodificada(
+    const std::string& codA,
+    const std::string& codB,
+    const std::vector<int>& perfil,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio
+);
+
 #endif // SECUENCIAL_H
 
@@ -0,0 +1,153 @@
+#ifndef SECUENCIAS_BINARIAS_H
+#define SECUENCIAS_BINARIAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "archivo_proyectado.h"
+#include "secuencia_dna.h"
+
+/**
+ * @file secuencias_binarias.h
+ * @brief Contenedor binario indexado de secuencias DNA a 2 bits (.nwb).
+ *
+ * Un FASTA de texto hay que volver a recorrerlo entero en cada ejecución
+ * (saltos de línea, validación, empaquetado). Este formato guarda cada
+ * registro ya empaquetado como SecuenciaDNA, con un índice al final: al
+ * proyectar el archivo, el registro r se localiza en O(1) y sus palabras se
+ * usan directamente desde la proyección.
+ *
+ * Disposición (enteros little-endian de la máquina, todo alineado a 8 bytes):
+ *
+ *     CabeceraSecuenciasBinarias                       (32 bytes)
+ *     por registro: palabras de 2 bits                 (8 · ceil(longitud / 32) bytes)
+ *                   tramos de excepciones              (16 bytes por tramo)
+ *                   texto de la cabecera FASTA         (relleno hasta múltiplo de 8)
+ *     índice: una EntradaIndiceBinario por registro    (48 bytes cada una)
+ *
+ * Las posiciones que no son ACGT (N, códigos IUPAC, '-') valen 0 en las
+ * palabras y se guardan como tramos (inicio, longitud, símbolo), así que una
+ * región de N de cualquier longitud ocupa 16 bytes. Las bases se guardan en
+ * mayúsculas, como en SecuenciaDNA.
+ */
+
+/** @brief Identificador al principio de todo archivo .nwb. */
+static const char MAGIA_SECUENCIAS_BINARIAS[4] = {'N', 'W', 'B', '2'};
+
+/** @brief Versión del formato (también detecta un archivo escrito con otro orden de bytes). */
+static const std::uint32_t VERSION_SECUENCIAS_BINARIAS = 1;
+
+/** @brief Cabecera del archivo. */
+struct CabeceraSecuenciasBinarias {
+    char magia[4];
+    std::uint32_t version;
+    std::uint64_t registros;
+    std::uint64_t indice;      /**< Desplazamiento del índice desde el principio del archivo. */
+    std::uint64_t reservado;
+};
+
+/** @brief Entrada del índice: dónde está cada parte del registro (desplazamientos en bytes). */
+struct EntradaIndiceBinario {
+    std::uint64_t longitud;            /**< Bases. */
+    std::uint64_t palabras;
+    std::uint64_t tramos;
+    std::uint64_t numero_tramos;
+    std::uint64_t cabecera;
+    std::uint64_t longitud_cabecera;
+};
+
+/** @brief Tramo de posiciones consecutivas con el mismo símbolo no ACGT. */
+struct TramoExcepcionBinario {
+    std::uint64_t inicio;
+    std::uint32_t longitud;
+    std::uint32_t simbolo;
+};
+
+/**
+ * @brief Escritor de archivos .nwb, registro a registro.
+ *
+ * Los registros se escriben según llegan; cerrar() añade el índice y
+ * completa la cabecera (el destructor lo hace si no se ha llamado).
+ */
+class EscritorSecuenciasBinarias {
+public:
+    explicit EscritorSecuenciasBinarias(const std::string& nombreArchivo);
+    ~EscritorSecuenciasBinarias();
+
+    EscritorSecuenciasBinarias(const EscritorSecuenciasBinarias&) = delete;
+    EscritorSecuenciasBinarias& operator=(const EscritorSecuenciasBinarias&) = delete;
+
+    bool abierto() const { return archivo_.is_open(); }
+    std::size_t registros() const { return indice_.size(); }
+
+    /** @brief Añade un registro (cabecera sin '>'). */
+    bool anadir(const std::string& cabecera, const SecuenciaDNA& secuencia);
+
+    /** @brief Escribe el índice y la cabecera definitiva; false si hubo algún error de escritura. */
+    bool cerrar();
+
+private:
+    void escribir(const void* datos, std::size_t bytes);
+
+    std::ofstream archivo_;
+    std::vector<EntradaIndiceBinario> indice_;
+    std::uint64_t posicion_;
+    bool cerrado_;
+};
+
+/**
+ * @brief Archivo .nwb proyectado en memoria, con acceso O(1) a cada registro.
+ *
+ * Al abrirlo solo se comprueban la cabecera y el índice; las bases y los
+ * tramos de excepciones no se leen (ni se validan) hasta que se pide un
+ * registro. La proyección no se precarga: abrir no depende del tamaño de
+ * los datos.
+ */
+class ArchivoSecuenciasBinario {
+public:
+    /** @brief Proyecta el archivo y valida el índice; si falla, abierto() es false (con mensaje). */
+    explicit ArchivoSecuenciasBinario(const std::string& nombreArchivo);
+
+    bool abierto() const { return valido_; }
+    std::size_t registros() const { return registros_; }
+
+    std::size_t longitud(std::size_t r) const { return indice_[r].longitud; }
+    std::string cabecera(std::size_t r) const;
+
+    /** @brief Palabras de 2 bits del registro r, sin copiar (válidas mientras viva el objeto). */
+    const std::uint64_t* palabras(std::size_t r) const;
+
+    /**
+     * @brief Registro r como SecuenciaDNA (copia las palabras y repone las excepciones).
+     *
+     * Si los tramos del registro no son válidos se avisa y se devuelven solo
+     * las bases de las palabras (igual en texto()).
+     */
+    SecuenciaDNA secuencia(std::size_t r) const;
+
+    /** @brief Registro r como texto en mayúsculas, decodificado directamente de la proyección. */
+    std::string texto(std::size_t r) const;
+
+private:
+    bool validar();
+    bool tramosValidos(std::size_t r) const;
+    const TramoExcepcionBinario* tramos(std::size_t r) const;
+
+    ArchivoProyectado archivo_;
+    const EntradaIndiceBinario* indice_;
+    std::size_t registros_;
+    bool valido_;
+};
+
+/** @brief true si el archivo empieza con la marca de un .nwb. */
+bool esArchivoSecuenciasBinario(const std::string& nombreArchivo);
+
+/**
+ * @brief Convierte un FASTA a .nwb (mismas cabeceras y registros que leerArchivoFasta).
+ * @return Número de registros escritos, o -1 si falla la lectura o la escritura.
+ */
+long long convertirFastaABinario(const std::string& archivo_fasta, const std::string& archivo_binario);
+
+#endif // SECUENCIAS_BINARIAS_H
@@ -0,0 +1,73 @@
+#ifndef SIMD_ESTRIADO_H
+#define SIMD_ESTRIADO_H
+
+#include <string>
+#include "tipos.h"
+
+/**
+ * @file simd_estriado.h
+ * @brief Kernel SIMD estriado (Farrar) para la puntuación de Needleman–Wunsch (DNA).
+ */
+
+/**
+ * @brief Conjunto de instrucciones usado por el kernel estriado.
+ */
+enum ConjuntoSimd {
+    SIMD_ESCALAR,   /**< Sin SIMD: se usa puntuacionNW. */
+    SIMD_SSE41,     /**< Vectores de 128 bits (8 celdas de 16 bits o 4 de 32 bits). */
+    SIMD_AVX2       /**< Vectores de 256 bits (16 celdas de 16 bits u 8 de 32 bits). */
+};
+
+/**
+ * @brief Detecta en tiempo de ejecución el mejor conjunto SIMD disponible.
+ * @return ConjuntoSimd AVX2 si la CPU lo soporta, si no SSE4.1, si no escalar.
+ */
+ConjuntoSimd detectarConjuntoSimd();
+
+/**
+ * @brief Nombre legible de un conjunto SIMD ("avx2", "sse4.1", "escalar").
+ */
+const char* nombreConjuntoSimd(ConjuntoSimd conjunto);
+
+/**
+ * @brief Calcula la puntuación NW con el kernel estriado de Farrar (sin alineamiento).
+ *
+ * La secuencia A se reparte en franjas: con L carriles por vector y
+ * seg = ceil(m / L), la posición i ocupa el carril i / seg del vector i % seg.
+ * Para cada símbolo de B se precalcula un perfil de consulta (un vector de
+ * puntuaciones por segmento), así cada columna de B se procesa con una suma,
+ * dos máximos y una carga de perfil por vector, sin llamar a
+ * obtenerPuntuacionDNA. La dependencia vertical (gap dentro de la columna)
+ * se corrige con el bucle "lazy-F" de Farrar, que casi siempre termina en
+ * una o dos iteraciones.
+ *
+ * Se usan celdas de 16 bits cuando el rango de puntuaciones posible cabe
+ * (el doble de carriles por instrucción) y de 32 bits en otro caso. Si la CPU
+ * no soporta SSE4.1, el gap no es negativo o la plataforma no es x86, se
+ * delega en puntuacionNW. La puntuación es idéntica a la de AlgNW.
+ *
+ * @param secA Secuencia A (DNA), dispuesta en vertical dentro de los vectores.
+ * @param secB Secuencia B (DNA), recorrida columna a columna.
+ * @param config Configuración de alineamiento.
+ * @return ResultadoAlineamiento con puntuación y tiempos (solo_puntuacion = true).
+ */
+ResultadoAlineamiento puntuacionNWSimd(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config
+);
+
+/**
+ * @brief Igual que puntuacionNWSimd pero forzando un conjunto de instrucciones.
+ *
+ * Si el conjunto pedido no está disponible en la CPU se usa el mejor disponible
+ * por debajo de él.
+ */
+ResultadoAlineamiento puntuacionNWSimd(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    ConjuntoSimd conjunto
+);
+
+#endif // SIMD_ESTRIADO_H
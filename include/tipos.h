@@ -1,6 +1,7 @@
 #ifndef TIPOS_H
 #define TIPOS_H
 
+#include <cstddef>
 #include <string>
 #include "puntuacion.h"
 
@@ -17,15 +18,27 @@ struct ResultadoAlineamiento {
     double tiempo_fase1_ms;       /**< Tiempo (ms) empleado en la inicialización. */
     double tiempo_fase2_ms;       /**< Tiempo (ms) empleado en el llenado DP. */
     double tiempo_fase3_ms;       /**< Tiempo (ms) empleado en el traceback. */
+    bool solo_puntuacion;         /**< true si solo se calculó la puntuación (secA/secB vacías). */
+    std::string cigar;            /**< CIGAR extendido (=, X, D, I) si se pidió salida compacta; secA/secB quedan vacías. */
+    /**
+     * true si la poda X-drop/Z-drop eliminó todas las celdas vivas antes de
+     * llegar a (m, n): puntuacion es la mejor vista y el alineamiento cubre
+     * solo los prefijos hasta la celda donde se obtuvo.
+     */
+    bool truncado;
+    std::size_t celdas_omitidas;  /**< Celdas de la matriz m x n que la poda no llegó a calcular. */
 
     ResultadoAlineamiento()
         : secA(""), secB(""), puntuacion(0),
-          tiempo_fase1_ms(0.0), tiempo_fase2_ms(0.0), tiempo_fase3_ms(0.0) {}
+          tiempo_fase1_ms(0.0), tiempo_fase2_ms(0.0), tiempo_fase3_ms(0.0),
+          solo_puntuacion(false), cigar(""), truncado(false), celdas_omitidas(0) {}
 
     ResultadoAlineamiento(const std::string& a, const std::string& b, int puntua,
-                         double llenado_ms = 0.0, double traceback_ms = 0.0, double inicializacion_ms = 0.0)
+                         double llenado_ms = 0.0, double traceback_ms = 0.0, double inicializacion_ms = 0.0,
+                         const std::string& cigar_compacto = "")
         : secA(a), secB(b), puntuacion(puntua), 
-          tiempo_fase1_ms(inicializacion_ms), tiempo_fase2_ms(llenado_ms), tiempo_fase3_ms(traceback_ms) {}
+          tiempo_fase1_ms(inicializacion_ms), tiempo_fase2_ms(llenado_ms), tiempo_fase3_ms(traceback_ms),
+          solo_puntuacion(false), cigar(cigar_compacto), truncado(false), celdas_omitidas(0) {}
 };
 
 /**
@@ -36,13 +49,38 @@ struct ResultadoAlineamiento {
 struct ConfiguracionAlineamiento {
     ConfiguracionPuntuacionDNA puntuacion;  /**< Configuración de puntuación DNA. */
     bool verbose;                            /**< Habilita salida verbosa si es true. */
+    /**
+     * Si es true, los motores que lo soportan (AlgNW, antidiagonal y bloques)
+     * guardan el predecesor de cada celda en una MatrizDirecciones de 2 bits
+     * y solo filas/diagonales rodantes de puntuación; el traceback sigue
+     * punteros en lugar de recalcular.
+     */
+    bool traceback_direcciones;
+    /**
+     * Si es true, el traceback produce solo el CIGAR en ResultadoAlineamiento::cigar
+     * y no materializa las secuencias con gaps.
+     */
+    bool salida_cigar;
+    /**
+     * Umbral de poda (0 = desactivada). AlgNW y el motor antidiagonal dejan
+     * de extender las celdas cuya puntuación cae más de xdrop por debajo de
+     * la mejor vista, y se detienen si no queda ninguna viva.
+     */
+    int xdrop;
+    /**
+     * Con poda activa, usa Z-drop en lugar de X-drop: el umbral se relaja en
+     * |gap| por cada diagonal de distancia a la mejor celda, para no cortar
+     * por un gap largo que el camino óptimo sí atraviesa.
+     */
+    bool zdrop;
     
     /**
      * @brief Constructor por defecto.
      * Usa match=2, mismatch=-1, gap=-2 por defecto.
      */
     ConfiguracionAlineamiento() 
-        : puntuacion(2, -1, -2), verbose(false) {}
+        : puntuacion(2, -1, -2), verbose(false), traceback_direcciones(false), salida_cigar(false),
+          xdrop(0), zdrop(false) {}
     
     /**
      * @brief Constructor con esquema simple (coincidencia/sustitución/gap).
@@ -52,7 +90,8 @@ struct ConfiguracionAlineamiento {
      * @param verboso Flag verbose.
      */
     ConfiguracionAlineamiento(int coincidencia, int sustitucion, int penalidad_gap, bool verboso = false)
-        : puntuacion(coincidencia, sustitucion, penalidad_gap), verbose(verboso) {}
+        : puntuacion(coincidencia, sustitucion, penalidad_gap), verbose(verboso),
+          traceback_direcciones(false), salida_cigar(false), xdrop(0), zdrop(false) {}
     
     /**
      * @brief Constructor con un objeto ConfiguracionPuntuacionDNA completo.
@@ -60,7 +99,8 @@ struct ConfiguracionAlineamiento {
      * @param verboso Flag verbose.
      */
     ConfiguracionAlineamiento(const ConfiguracionPuntuacionDNA& config_punt, bool verboso = false)
-        : puntuacion(config_punt), verbose(verboso) {}
+        : puntuacion(config_punt), verbose(verboso), traceback_direcciones(false), salida_cigar(false),
+          xdrop(0), zdrop(false) {}
 };
 
 #endif // TIPOS_H
@@ -0,0 +1,109 @@
+#ifndef TRACEBACK_H
+#define TRACEBACK_H
+
+#include <cstddef>
+#include <string>
+#include "tipos.h"
+#include "matriz_dp.h"
+#include "matriz_direcciones.h"
+
+/**
+ * @file traceback.h
+ * @brief Reconstrucción del alineamiento (fase 3) común a los motores NW (DNA).
+ *
+ * Los recorridos van de (m, n) a (0, 0) y anotan cada paso en un buffer
+ * reservado de antemano (longitud máxima m + n), que se invierte una sola
+ * vez al final: O(m + n) en lugar de anteponer un carácter a un std::string
+ * en cada paso (O(L²) copias).
+ *
+ * El resultado es, según config.salida_cigar, o bien las dos secuencias con
+ * gaps, o bien un CIGAR extendido tomando A como referencia:
+ * '=' coincidencia, 'X' sustitución, 'D' carácter de A frente a gap
+ * (eliminación) e 'I' carácter de B frente a gap (inserción); por ejemplo
+ * "12=1X3I40=". En modo CIGAR no se materializan las secuencias con gaps.
+ */
+
+/** @brief Pasos de un camino de traceback, anotados de (m, n) hacia (0, 0). */
+const char PASO_DIAGONAL = 'M';   /**< (i-1, j-1): coincidencia o sustitución. */
+const char PASO_ARRIBA = 'D';     /**< (i-1, j): carácter de A frente a gap. */
+const char PASO_IZQUIERDA = 'I';  /**< (i, j-1): carácter de B frente a gap. */
+
+/**
+ * @brief Convierte un camino (pasos en orden inverso) en la salida pedida.
+ *
+ * Para motores con almacenamiento propio (p. ej. en banda) que recorren el
+ * camino por su cuenta.
+ *
+ * @param pasos Pasos PASO_* de (m, n) hacia (0, 0).
+ * @param secA Secuencia A original.
+ * @param secB Secuencia B original.
+ * @param config Configuración (salida_cigar).
+ * @param alineadaA Salida: A con gaps (vacía en modo CIGAR).
+ * @param alineadaB Salida: B con gaps (vacía en modo CIGAR).
+ * @param cigar Salida: CIGAR (vacío si no se pidió).
+ */
+void construirSalidaTraceback(const std::string& pasos,
+                              const std::string& secA, const std::string& secB,
+                              const ConfiguracionAlineamiento& config,
+                              std::string& alineadaA, std::string& alineadaB,
+                              std::string& cigar);
+
+/**
+ * @brief Traceback recalculando las decisiones sobre la matriz de puntuaciones.
+ *
+ * Acepta cualquier disposición de MatrizDP. Ante empate prefiere diagonal,
+ * luego eliminación y luego inserción (el criterio histórico de AlgNW).
+ *
+ * @param F Matriz DP de (m + 1) x (n + 1) ya llena.
+ * @param secA Secuencia A original.
+ * @param secB Secuencia B original.
+ * @param config Configuración (puntuación y salida_cigar).
+ * @param alineadaA Salida: A con gaps (vacía en modo CIGAR).
+ * @param alineadaB Salida: B con gaps (vacía en modo CIGAR).
+ * @param cigar Salida: CIGAR (vacío si no se pidió).
+ */
+void tracebackMatrizDP(const MatrizDP& F,
+                       const std::string& secA, const std::string& secB,
+                       const ConfiguracionAlineamiento& config,
+                       std::string& alineadaA, std::string& alineadaB,
+                       std::string& cigar);
+
+/** @brief tracebackMatrizDP anotando el camino en un buffer del llamador (pasos). */
+void tracebackMatrizDP(const MatrizDP& F,
+                       const std::string& secA, const std::string& secB,
+                       const ConfiguracionAlineamiento& config,
+                       std::string& alineadaA, std::string& alineadaB,
+                       std::string& cigar, std::string& pasos);
+
+/**
+ * @brief Traceback siguiendo los punteros de una matriz de direcciones.
+ *
+ * No recalcula puntuaciones. Mismos parámetros de salida que tracebackMatrizDP.
+ */
+void tracebackDirecciones(const MatrizDirecciones& direcciones,
+                          const std::string& secA, const std::string& secB,
+                          const ConfiguracionAlineamiento& config,
+                          std::string& alineadaA, std::string& alineadaB,
+                          std::string& cigar);
+
+/** @brief tracebackDirecciones anotando el camino en un buffer del llamador (pasos). */
+void tracebackDirecciones(const MatrizDirecciones& direcciones,
+                          const std::string& secA, const std::string& secB,
+                          const ConfiguracionAlineamiento& config,
+                          std::string& alineadaA, std::string& alineadaB,
+                          std::string& cigar, std::string& pasos);
+
+/**
+ * @brief Calcula el CIGAR extendido de un alineamiento ya materializado.
+ * @param alineadaA Secuencia A con gaps.
+ * @param alineadaB Secuencia B con gaps (misma longitud).
+ * @return std::string CIGAR ('=', 'X', 'D', 'I').
+ */
+std::string cigarDesdeAlineamiento(const std::string& alineadaA, const std::string& alineadaB);
+
+/**
+ * @brief Número de columnas del alineamiento descrito por un CIGAR.
+ */
+std::size_t longitudCIGAR(const std::string& cigar);
+
+#endif // TRACEBACK_H
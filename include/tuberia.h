@@ -0,0 +1,152 @@
+#ifndef TUBERIA_H
+#define TUBERIA_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "tipos.h"
+
+/**
+ * @file tuberia.h
+ * @brief Alineamiento en flujo de FASTA muy grandes: lectura, alineamiento y escritura solapados (DNA).
+ *
+ * alinearLote necesita todas las secuencias en memoria antes de empezar.
+ * Aquí un thread lector produce los pares consecutivos (registros 1-2,
+ * 3-4, ...) con LectorFasta, un grupo de threads los alinea y un thread
+ * escritor consume los resultados; las etapas se comunican por colas
+ * acotadas, así que la memoria depende de la capacidad de las colas y no
+ * del tamaño del archivo.
+ */
+
+/**
+ * @brief Cola FIFO acotada y bloqueante entre etapas (mutex + variables de condición).
+ */
+template <typename T>
+class ColaAcotada {
+public:
+    explicit ColaAcotada(std::size_t capacidad) : capacidad_(capacidad > 0 ? capacidad : 1), cerrada_(false) {}
+
+    /**
+     * @brief Añade un elemento, esperando mientras la cola esté llena.
+     * @return false si la cola se cerró (el elemento se descarta).
+     */
+    bool poner(T elemento) {
+        std::unique_lock<std::mutex> cerrojo(mutex_);
+        no_llena_.wait(cerrojo, [this] { return cerrada_ || elementos_.size() < capacidad_; });
+        if (cerrada_) {
+            return false;
+        }
+        elementos_.push_back(std::move(elemento));
+        no_vacia_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Extrae el primer elemento, esperando mientras la cola esté vacía.
+     * @return false si la cola está cerrada y ya no quedan elementos.
+     */
+    bool tomar(T& elemento) {
+        std::unique_lock<std::mutex> cerrojo(mutex_);
+        no_vacia_.wait(cerrojo, [this] { return cerrada_ || !elementos_.empty(); });
+        if (elementos_.empty()) {
+            return false;
+        }
+        elemento = std::move(elementos_.front());
+        elementos_.pop_front();
+        no_llena_.notify_one();
+        return true;
+    }
+
+    /** @brief No admite más elementos; los consumidores vacían los que queden. */
+    void cerrar() {
+        std::lock_guard<std::mutex> cerrojo(mutex_);
+        cerrada_ = true;
+        no_vacia_.notify_all();
+        no_llena_.notify_all();
+    }
+
+private:
+    std::size_t capacidad_;
+    bool cerrada_;
+    std::deque<T> elementos_;
+    std::mutex mutex_;
+    std::condition_variable no_vacia_;
+    std::condition_variable no_llena_;
+};
+
+/** @brief Opciones de alinearEnTuberia. */
+struct OpcionesTuberia {
+    std::size_t capacidad_cola;   /**< Pares (y resultados) que caben en cada cola. */
+    int trabajadores;             /**< Threads de alineamiento (0 = omp_get_max_threads() - 2, al menos 1). */
+    bool solo_puntuacion;         /**< true: solo puntuación; false: alineamiento completo. */
+
+    OpcionesTuberia() : capacidad_cola(64), trabajadores(0), solo_puntuacion(true) {}
+};
+
+/** @brief Resultado de un par, tal como lo recibe el escritor. */
+struct ParAlineado {
+    std::size_t indice;            /**< Índice del par en el archivo (0 = registros 1-2). */
+    std::size_t longitud_a;
+    std::size_t longitud_b;
+    int thread;                    /**< Thread de alineamiento que lo calculó. */
+    int trabajadores;              /**< Threads de alineamiento de la tubería (tras recortarlos a los disponibles). */
+    ResultadoAlineamiento resultado;
+};
+
+/**
+ * @brief Contadores de una etapa.
+ *
+ * ocupado_ms es el tiempo trabajando y espera_ms el bloqueado en las colas,
+ * ambos sumados sobre los threads de la etapa. La etapa que limita el
+ * rendimiento es la de mayor utilización: ocupado_ms / (threads · tiempo total).
+ */
+struct EstadisticasEtapa {
+    std::size_t elementos;   /**< Pares leídos, alineados o escritos. */
+    std::size_t volumen;     /**< Bases leídas, celdas m·n alineadas o filas escritas. */
+    double ocupado_ms;
+    double espera_ms;
+    int threads;
+
+    EstadisticasEtapa() : elementos(0), volumen(0), ocupado_ms(0.0), espera_ms(0.0), threads(0) {}
+
+    /** @brief Fracción del tiempo total en que la etapa estuvo trabajando. */
+    double utilizacion(double tiempo_total_ms) const {
+        return (tiempo_total_ms > 0.0 && threads > 0) ? ocupado_ms / (threads * tiempo_total_ms) : 0.0;
+    }
+};
+
+/** @brief Resultado de alinearEnTuberia. */
+struct ResultadoTuberia {
+    EstadisticasEtapa lectura;
+    EstadisticasEtapa alineamiento;
+    EstadisticasEtapa escritura;
+    double tiempo_total_ms;
+    bool correcto;   /**< false si no se pudo abrir el archivo. */
+
+    ResultadoTuberia() : tiempo_total_ms(0.0), correcto(false) {}
+};
+
+/**
+ * @brief Alinea en flujo los pares consecutivos de un FASTA.
+ *
+ * Una región OpenMP de trabajadores + 2 threads: el thread 0 lee, el 1
+ * llama a escribir por cada resultado (en orden de llegada, no de índice)
+ * y el resto alinea con alinearPar, cada uno con su EspacioTrabajo.
+ * Si la última secuencia queda sin pareja se descarta, como en
+ * paresConsecutivos.
+ *
+ * @param archivo_fasta FASTA de entrada.
+ * @param config Configuración de alineamiento común.
+ * @param opciones Capacidad de las colas, trabajadores y modo.
+ * @param escribir Se llama desde el thread escritor con cada resultado.
+ * @return ResultadoTuberia con las estadísticas de cada etapa.
+ */
+ResultadoTuberia alinearEnTuberia(const std::string& archivo_fasta,
+                                  const ConfiguracionAlineamiento& config,
+                                  const OpcionesTuberia& opciones,
+                                  const std::function<void(const ParAlineado&)>& escribir);
+
+#endif // TUBERIA_H
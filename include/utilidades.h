@@ -1,9 +1,14 @@
 #ifndef UTILIDADES_H
 #define UTILIDADES_H
 
+#include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 #include "tipos.h"
+#include "secuencia_dna.h"
+
+class ArchivoSecuenciasBinario;
 
 /**
  * @brief Imprime un alineamiento en formato legible por humanos.
@@ -63,10 +68,55 @@ void compararResultadosDetallado(
 
 /**
  * @brief Lee todas las secuencias encontradas en un archivo FASTA.
+ *
+ * Si el archivo es un contenedor .nwb (secuencias_binarias.h) se lee de
+ * él, ya en mayúsculas.
+ *
  * @param nombreArchivo Ruta del archivo FASTA.
  * @return std::vector<std::string> Vector con las secuencias leídas.
  */
 std::vector<std::string> leerArchivoFasta(const std::string& nombreArchivo);
 
+/**
+ * @brief Lee todas las secuencias de un archivo FASTA empaquetándolas a 2 bits por base.
+ *
+ * Cada línea se añade directamente a la SecuenciaDNA, sin acumular la
+ * secuencia completa como std::string: un FASTA con muchas secuencias ocupa
+ * ~1/4 de memoria. Las secuencias quedan normalizadas a mayúsculas.
+ * Un .nwb se carga copiando las palabras empaquetadas, sin decodificar.
+ *
+ * @param nombreArchivo Ruta del archivo FASTA.
+ * @return std::vector<SecuenciaDNA> Vector con las secuencias leídas.
+ */
+std::vector<SecuenciaDNA> leerArchivoFastaDNA(const std::string& nombreArchivo);
+
+/**
+ * @brief Lector FASTA en flujo: devuelve una secuencia cada vez.
+ *
+ * Mismo criterio que leerArchivoFasta, pero la memoria no depende del
+ * tamaño del archivo: solo se guarda la secuencia que se está leyendo. Un
+ * .nwb se recorre registro a registro sobre su proyección, decodificando
+ * cada uno al pedirlo.
+ */
+class LectorFasta {
+public:
+    explicit LectorFasta(const std::string& nombreArchivo);
+    ~LectorFasta();
+
+    bool abierto() const;
+
+    /**
+     * @brief Lee la siguiente secuencia (sin cabecera ni saltos de línea).
+     * @return false al llegar al final del archivo sin más secuencias.
+     */
+    bool siguiente(std::string& secuencia);
+
+private:
+    std::ifstream archivo_;
+    std::string linea_;
+    std::unique_ptr<ArchivoSecuenciasBinario> binario_;  /**< Solo si el archivo es un .nwb. */
+    std::size_t registro_;                               /**< Siguiente registro del .nwb. */
+};
+
 #endif // UTILIDADES_H
 
@@ -0,0 +1,236 @@
+#include "afin.h"
+#include "puntuacion.h"
+#include "matriz_direcciones.h"
+#include "traceback.h"
+#include "espacio_trabajo.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+MatrizEstadosAfin::MatrizEstadosAfin()
+    : filas_(0), columnas_(0), stride_(0), disposicion_(DISPOSICION_FILAS) {}
+
+MatrizEstadosAfin::MatrizEstadosAfin(int filas, int columnas, DisposicionMatriz disposicion) {
+    redimensionar(filas, columnas, disposicion);
+    std::fill(datos_.begin(), datos_.end(), 0);
+}
+
+void MatrizEstadosAfin::redimensionar(int filas, int columnas, DisposicionMatriz disposicion) {
+    filas_ = filas;
+    columnas_ = columnas;
+    stride_ = 0;
+    disposicion_ = disposicion;
+    const std::size_t linea = MatrizDP::ALINEACION_BYTES;
+    // resize no libera capacidad: al reducir, el buffer se conserva
+    if (disposicion_ == DISPOSICION_DIAGONALES) {
+        int num_diagonales = (filas > 0 && columnas > 0) ? filas + columnas - 1 : 0;
+        inicio_diagonal_.resize(num_diagonales + 1);
+        std::size_t posicion = 0;
+        for (int d = 0; d < num_diagonales; ++d) {
+            inicio_diagonal_[d] = posicion;
+            int i_min = std::max(0, d - (columnas - 1));
+            int i_max = std::min(filas - 1, d);
+            std::size_t longitud = static_cast<std::size_t>(i_max - i_min + 1);
+            posicion += (longitud + linea - 1) / linea * linea;
+        }
+        inicio_diagonal_[num_diagonales] = posicion;
+        datos_.resize(posicion);
+    } else {
+        stride_ = (static_cast<std::size_t>(columnas) + linea - 1) / linea * linea;
+        datos_.resize(stride_ * filas);
+    }
+}
+
+void tracebackAfin(const MatrizEstadosAfin& estados,
+                   const std::string& secA, const std::string& secB,
+                   const ConfiguracionAlineamiento& config,
+                   std::string& alineadaA, std::string& alineadaB,
+                   std::string& cigar) {
+    std::string pasos;
+    tracebackAfin(estados, secA, secB, config, alineadaA, alineadaB, cigar, pasos);
+}
+
+void tracebackAfin(const MatrizEstadosAfin& estados,
+                   const std::string& secA, const std::string& secB,
+                   const ConfiguracionAlineamiento& config,
+                   std::string& alineadaA, std::string& alineadaB,
+                   std::string& cigar, std::string& pasos) {
+    enum EstadoAfin { EN_H, EN_F, EN_E };
+    int i = estados.filas() - 1;
+    int j = estados.columnas() - 1;
+    pasos.clear();
+    pasos.reserve(static_cast<std::size_t>(i) + j);
+
+    EstadoAfin estado = EN_H;
+    while (i > 0 && j > 0) {
+        unsigned char celda = estados(i, j);
+        if (estado == EN_H) {
+            int origen = celda & AFIN_ORIGEN_H;
+            if (origen == DIR_DIAGONAL) {
+                pasos.push_back(PASO_DIAGONAL);
+                --i; --j;
+                continue;
+            }
+            estado = (origen == DIR_ARRIBA) ? EN_F : EN_E;
+        }
+        // Dentro de un gap: se sigue en él mientras la celda lo extienda
+        if (estado == EN_F) {
+            pasos.push_back(PASO_ARRIBA);
+            if (!(celda & AFIN_EXTIENDE_F)) estado = EN_H;
+            --i;
+        } else {
+            pasos.push_back(PASO_IZQUIERDA);
+            if (!(celda & AFIN_EXTIENDE_E)) estado = EN_H;
+            --j;
+        }
+    }
+    pasos.append(i, PASO_ARRIBA);
+    pasos.append(j, PASO_IZQUIERDA);
+
+    construirSalidaTraceback(pasos, secA, secB, config, alineadaA, alineadaB, cigar);
+}
+
+ResultadoAlineamiento alineamientoNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWAfin(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+
+    int m = secA.length();
+    int n = secB.length();
+
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    int gap = config.puntuacion.parametros.gap;
+    int apertura = config.puntuacion.parametros.apertura;
+    int abre = apertura + gap;
+    MatrizEstadosAfin& estados = espacio.estadosAfin(m + 1, n + 1);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
+    // H: última fila calculada; F: gap vertical que llega a cada columna
+    std::vector<int>& H = espacio.anterior;
+    std::vector<int>& F = espacio.actual;
+    H.resize(n + 1);
+    F.assign(n + 1, AFIN_MENOS_INFINITO);
+    H[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        H[j] = apertura + j * gap;
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // FASE 2: Llenado fila a fila
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    for (int i = 1; i <= m; ++i) {
+        int diagonal = H[0];
+        H[0] = apertura + i * gap;
+        int E = AFIN_MENOS_INFINITO;
+        unsigned char* fila_estados = estados.fila(i);
+        const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+        for (int j = 1; j <= n; ++j) {
+            int coincidencia = diagonal + perfil_fila[j-1];
+            int abre_e = H[j-1] + abre;
+            int extiende_e = E + gap;
+            int abre_f = H[j] + abre;
+            int extiende_f = F[j] + gap;
+            E = std::max(abre_e, extiende_e);
+            F[j] = std::max(abre_f, extiende_f);
+            diagonal = H[j];
+            H[j] = std::max({coincidencia, E, F[j]});
+            fila_estados[j] = estadoCeldaAfin(coincidencia, abre_e, extiende_e, abre_f, extiende_f);
+        }
+    }
+    int puntuacion = H[n];
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackAfin(estados, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+int puntuacionNWAfinCodificada(const std::string& codA, const std::string& codB,
+                               const std::vector<int>& perfil,
+                               const ConfiguracionAlineamiento& config,
+                               EspacioTrabajo& espacio) {
+    int m = codA.length();
+    int n = codB.length();
+    int gap = config.puntuacion.parametros.gap;
+    int apertura = config.puntuacion.parametros.apertura;
+    int abre = apertura + gap;
+    espacio.anterior.resize(n + 1);
+    espacio.actual.assign(n + 1, AFIN_MENOS_INFINITO);
+    int* H = espacio.anterior.data();
+    int* F = espacio.actual.data();
+    H[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        H[j] = apertura + j * gap;
+    }
+
+    for (int i = 1; i <= m; ++i) {
+        int diagonal = H[0];
+        // H[j-1] en un registro: con H y F en el espacio el compilador no
+        // puede descartar que se solapen y la releería de memoria
+        int izquierda = apertura + i * gap;
+        H[0] = izquierda;
+        int E = AFIN_MENOS_INFINITO;
+        const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+        for (int j = 1; j <= n; ++j) {
+            E = std::max(izquierda + abre, E + gap);
+            F[j] = std::max(H[j] + abre, F[j] + gap);
+            int coincidencia = diagonal + perfil_fila[j-1];
+            diagonal = H[j];
+            izquierda = std::max({coincidencia, E, F[j]});
+            H[j] = izquierda;
+        }
+    }
+    return H[n];
+}
+
+ResultadoAlineamiento puntuacionNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return puntuacionNWAfin(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento puntuacionNWAfin(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    int puntuacion = puntuacionNWAfinCodificada(espacio.codA, espacio.codB, espacio.perfil, config, espacio);
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    ResultadoAlineamiento resultado("", "", puntuacion, tiempo_fase2_ms, 0.0, tiempo_fase1_ms);
+    resultado.solo_puntuacion = true;
+    return resultado;
+}
@@ -0,0 +1,68 @@
+#include "archivo_proyectado.h"
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Lee el archivo entero a un buffer (sin mmap o si no es un archivo regular).
+ */
+static bool leerCompleto(const std::string& nombreArchivo, std::vector<char>& copia) {
+    std::ifstream archivo(nombreArchivo, std::ios::binary);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    copia.assign(std::istreambuf_iterator<char>(archivo), std::istreambuf_iterator<char>());
+    return true;
+}
+
+ArchivoProyectado::ArchivoProyectado(const std::string& nombreArchivo, bool precargar)
+    : datos_(nullptr), tamano_(0), abierto_(false) {
+    bool proyectado = false;
+#ifndef _WIN32
+    int fd = open(nombreArchivo.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        tamano_ = static_cast<std::size_t>(info.st_size);
+        proyectado = true;
+        if (tamano_ > 0) {
+            int opciones = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (precargar) opciones |= MAP_POPULATE;
+#endif
+            void* p = mmap(nullptr, tamano_, PROT_READ, opciones, fd, 0);
+            if (p == MAP_FAILED) {
+                tamano_ = 0;
+                proyectado = false;
+            } else {
+                if (precargar) madvise(p, tamano_, MADV_WILLNEED);
+                datos_ = static_cast<const char*>(p);
+            }
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+    if (!proyectado) {
+        if (!leerCompleto(nombreArchivo, copia_)) {
+            return;
+        }
+        datos_ = copia_.data();
+        tamano_ = copia_.size();
+    }
+    abierto_ = true;
+}
+
+ArchivoProyectado::~ArchivoProyectado() {
+#ifndef _WIN32
+    if (datos_ != nullptr && datos_ != copia_.data()) {
+        munmap(const_cast<char*>(datos_), tamano_);
+    }
+#endif
+}
@@ -0,0 +1,217 @@
+#include "banda.h"
+#include "puntuacion.h"
+#include "traceback.h"
+#include "afin.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+// -infinito para celdas fuera de la banda (margen para sumar penalidades)
+static const int FUERA_DE_BANDA = INT_MIN / 4;
+
+/**
+ * @brief Banda de la DP: B[i * ancho + t] = F(i, i + diag_min + t).
+ */
+struct Banda {
+    int diag_min;
+    int diag_max;
+    int ancho;
+    std::vector<int> B;
+};
+
+/**
+ * @brief Ajusta la banda a la matriz y a las diagonales 0 y n - m, y reserva
+ *        e inicializa sus fronteras.
+ */
+static void prepararBanda(Banda& banda, int m, int n, int diag_min, int diag_max, int penalidadGap) {
+    // El camino va de la diagonal 0 a la diagonal n - m
+    banda.diag_min = std::max(std::min({diag_min, 0, n - m}), -m);
+    banda.diag_max = std::min(std::max({diag_max, 0, n - m}), n);
+    banda.ancho = banda.diag_max - banda.diag_min + 1;
+    banda.B.assign(static_cast<size_t>(m + 1) * banda.ancho, FUERA_DE_BANDA);
+    for (int j = 0; j <= std::min(n, banda.diag_max); ++j) {
+        banda.B[j - banda.diag_min] = j * penalidadGap;
+    }
+    for (int i = 1; i <= std::min(m, -banda.diag_min); ++i) {
+        banda.B[static_cast<size_t>(i) * banda.ancho - i - banda.diag_min] = i * penalidadGap;
+    }
+}
+
+/**
+ * @brief Llena la banda fila a fila y devuelve F(m, n).
+ */
+static int llenarBanda(Banda& banda, const std::string& codA, const std::vector<int>& perfil,
+                       int n, int penalidadGap) {
+    int m = codA.length();
+    int ancho = banda.ancho;
+    for (int i = 1; i <= m; ++i) {
+        int j_inicio = std::max(1, i + banda.diag_min);
+        int j_fin = std::min(n, i + banda.diag_max);
+        int* fila = &banda.B[static_cast<size_t>(i) * ancho];
+        const int* previa = &banda.B[static_cast<size_t>(i - 1) * ancho];
+        const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+        for (int j = j_inicio; j <= j_fin; ++j) {
+            // Misma columna t de la banda = misma diagonal en la fila anterior
+            int t = j - i - banda.diag_min;
+            int coincidencia = previa[t] + perfil_fila[j-1];
+            int eliminacion = (t + 1 < ancho) ? previa[t + 1] + penalidadGap : FUERA_DE_BANDA;
+            int insercion = (t > 0) ? fila[t - 1] + penalidadGap : FUERA_DE_BANDA;
+            fila[t] = std::max({coincidencia, eliminacion, insercion});
+        }
+    }
+    return banda.B[static_cast<size_t>(m) * ancho + (n - m - banda.diag_min)];
+}
+
+/**
+ * @brief Traceback por recálculo dentro de la banda (misma prioridad que AlgNW).
+ */
+static void recorrerBanda(const Banda& banda, const std::string& codA, const std::vector<int>& perfil,
+                          const std::string& secA, const std::string& secB,
+                          const ConfiguracionAlineamiento& config, int penalidadGap,
+                          std::string& alineadaA, std::string& alineadaB, std::string& cigar) {
+    int m = secA.length();
+    int n = secB.length();
+    int ancho = banda.ancho;
+    std::string pasos;
+    pasos.reserve(static_cast<size_t>(m) + n);
+    int i = m, j = n;
+    while (i > 0 && j > 0) {
+        int t = j - i - banda.diag_min;
+        int actual = banda.B[static_cast<size_t>(i) * ancho + t];
+        if (actual == banda.B[static_cast<size_t>(i - 1) * ancho + t]
+                      + perfil[static_cast<size_t>(codA[i-1]) * n + (j-1)]) {
+            pasos.push_back(PASO_DIAGONAL);
+            --i; --j;
+        } else if (t + 1 < ancho && actual == banda.B[static_cast<size_t>(i - 1) * ancho + t + 1] + penalidadGap) {
+            pasos.push_back(PASO_ARRIBA);
+            --i;
+        } else {
+            pasos.push_back(PASO_IZQUIERDA);
+            --j;
+        }
+    }
+    pasos.append(i, PASO_ARRIBA);
+    pasos.append(j, PASO_IZQUIERDA);
+
+    construirSalidaTraceback(pasos, secA, secB, config, alineadaA, alineadaB, cigar);
+}
+
+ResultadoAlineamiento alineamientoNWBanda(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    int diag_min,
+    int diag_max) {
+
+    int m = secA.length();
+    int n = secB.length();
+
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    std::string codA = codificarIUPAC(secA);
+    std::vector<int> perfil = construirPerfilConsulta(codificarIUPAC(secB), TablaSustitucionDNA(config.puntuacion));
+    Banda banda;
+    prepararBanda(banda, m, n, diag_min, diag_max, penalidadGap);
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // FASE 2: Llenado de la banda
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    int puntuacion = llenarBanda(banda, codA, perfil, n, penalidadGap);
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    recorrerBanda(banda, codA, perfil, secA, secB, config, penalidadGap, alineadaA, alineadaB, cigar);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+bool bandaGarantizaOptimo(const ConfiguracionPuntuacionDNA& config, int m, int n,
+                          int diag_min, int diag_max, int puntuacion_banda) {
+    bool sale_por_arriba = diag_max < n;
+    bool sale_por_abajo = diag_min > -m;
+    if (!sale_por_arriba && !sale_por_abajo) {
+        return true;  // La banda es la matriz completa
+    }
+    int mejor = std::max(config.parametros.coincidencia, config.parametros.sustitucion);
+    long long gap = config.parametros.gap;
+    // Cada gap de más debe costar más de lo que ahorra medio paso diagonal
+    if (2 * gap >= mejor) {
+        return false;
+    }
+    // Mínimo de gaps de un camino que toca la diagonal d: |d| + |(n - m) - d|
+    long long gaps = -1;
+    if (sale_por_arriba) {
+        long long d = diag_max + 1;
+        gaps = 2 * d - (n - m);
+    }
+    if (sale_por_abajo) {
+        long long d = diag_min - 1;
+        long long g = (n - m) - 2 * d;
+        gaps = (gaps < 0) ? g : std::min(gaps, g);
+    }
+    // Con G gaps quedan (m + n - G) / 2 pasos diagonales de a lo sumo 'mejor'
+    long long cota_doble = mejor * (static_cast<long long>(m) + n - gaps) + 2 * gap * gaps;
+    return 2 * static_cast<long long>(puntuacion_banda) >= cota_doble;
+}
+
+ResultadoAlineamiento alineamientoNWBandaAdaptativa(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    int semiancho_inicial,
+    int* semiancho_final) {
+
+    if (config.puntuacion.gapAfin()) {
+        return alineamientoNWAfin(secA, secB, config);
+    }
+    int m = secA.length();
+    int n = secB.length();
+
+    // FASE 1: Inicialización (perfil común a todos los intentos)
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    std::string codA = codificarIUPAC(secA);
+    std::vector<int> perfil = construirPerfilConsulta(codificarIUPAC(secB), TablaSustitucionDNA(config.puntuacion));
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // FASE 2: Llenado con banda creciente hasta que la cota demuestra el óptimo
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    int semiancho = std::max(1, semiancho_inicial);
+    Banda banda;
+    int puntuacion;
+    while (true) {
+        prepararBanda(banda, m, n, std::min(0, n - m) - semiancho, std::max(0, n - m) + semiancho, penalidadGap);
+        puntuacion = llenarBanda(banda, codA, perfil, n, penalidadGap);
+        if (bandaGarantizaOptimo(config.puntuacion, m, n, banda.diag_min, banda.diag_max, puntuacion)) {
+            break;
+        }
+        semiancho *= 2;
+    }
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    if (semiancho_final != nullptr) {
+        *semiancho_final = semiancho;
+    }
+
+    // FASE 3: Traceback solo sobre la banda definitiva
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    recorrerBanda(banda, codA, perfil, secA, secB, config, penalidadGap, alineadaA, alineadaB, cigar);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
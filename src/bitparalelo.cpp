@@ -0,0 +1,167 @@
+#include "bitparalelo.h"
+#include "secuencial.h"
+#include "banda.h"
+#include "puntuacion.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+typedef std::uint64_t Palabra;
+static const int BITS_PALABRA = 64;
+
+/**
+ * @brief Perfil de coincidencias de a: peq[codigo * palabras + w] tiene a 1 el
+ *        bit r si a[64w + r] tiene ese código IUPAC.
+ */
+struct PerfilBits {
+    int palabras;
+    std::vector<Palabra> peq;
+};
+
+static void construirPerfil(const std::string& a, PerfilBits& perfil) {
+    int m = a.length();
+    perfil.palabras = (m + BITS_PALABRA - 1) / BITS_PALABRA;
+
+    // Las filas de relleno de la última palabra no coinciden con nada;
+    // no afectan a las filas <= m (la DP solo fluye hacia abajo). Los
+    // símbolos de código 0 tampoco: así la fila 0 del perfil queda vacía.
+    perfil.peq.assign(static_cast<size_t>(TAM_ALFABETO_IUPAC) * perfil.palabras, 0);
+    for (int i = 0; i < m; ++i) {
+        int codigo = codigoIUPAC(a[i]);
+        if (codigo != 0) {
+            perfil.peq[static_cast<size_t>(codigo) * perfil.palabras + i / BITS_PALABRA]
+                |= Palabra(1) << (i % BITS_PALABRA);
+        }
+    }
+}
+
+/**
+ * @brief Avanza una palabra de la columna (Hyyrö): actualiza Pv/Mv y devuelve
+ *        la diferencia horizontal que sale por la última fila de la palabra.
+ *
+ * @param hin Diferencia horizontal que entra por la fila superior (-1, 0 o +1).
+ */
+static inline int avanzarPalabra(Palabra& Pv, Palabra& Mv, Palabra Eq, int hin) {
+    Palabra hin_negativo = (hin < 0) ? 1 : 0;
+    Palabra Xv = Eq | Mv;
+    Eq |= hin_negativo;
+    Palabra Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+    Palabra Ph = Mv | ~(Xh | Pv);
+    Palabra Mh = Pv & Xh;
+    int hout = static_cast<int>(Ph >> (BITS_PALABRA - 1)) - static_cast<int>(Mh >> (BITS_PALABRA - 1));
+    Ph <<= 1;
+    Mh <<= 1;
+    Mh |= hin_negativo;
+    Ph |= (hin > 0) ? 1 : 0;
+    Pv = Mh | ~(Xv | Ph);
+    Mv = Ph & Xv;
+    return hout;
+}
+
+static int distanciaConPerfil(const PerfilBits& perfil, int m, const std::string& b) {
+    int palabras = perfil.palabras;
+    if (palabras == 0) {
+        return b.length();
+    }
+    // Columna 0: D[i][0] = i, todas las diferencias verticales son +1
+    std::vector<Palabra> Pv(palabras, ~Palabra(0));
+    std::vector<Palabra> Mv(palabras, 0);
+    // D en la última fila de la última palabra (incluye relleno)
+    int puntuacion = palabras * BITS_PALABRA;
+
+    for (char c : b) {
+        const Palabra* eq = &perfil.peq[static_cast<size_t>(codigoIUPAC(c)) * palabras];
+        int h = 1;  // fila 0: D[0][j] = j, diferencia horizontal +1
+        for (int w = 0; w < palabras; ++w) {
+            h = avanzarPalabra(Pv[w], Mv[w], eq[w], h);
+        }
+        puntuacion += h;
+    }
+
+    // Restar las diferencias verticales de las filas de relleno (m, 64·palabras]
+    int bit_inicio = m - (palabras - 1) * BITS_PALABRA;
+    for (int r = bit_inicio; r < BITS_PALABRA; ++r) {
+        puntuacion -= static_cast<int>((Pv[palabras - 1] >> r) & 1);
+        puntuacion += static_cast<int>((Mv[palabras - 1] >> r) & 1);
+    }
+    return puntuacion;
+}
+
+int distanciaEdicionBitParalela(const std::string& a, const std::string& b) {
+    PerfilBits perfil;
+    construirPerfil(a, perfil);
+    return distanciaConPerfil(perfil, a.length(), b);
+}
+
+ResultadoAlineamiento puntuacionNWBitParalelo(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+
+    if (!config.puntuacion.equivalenteDistanciaEdicion()) {
+        return puntuacionNW(secA, secB, config);
+    }
+    int m = secA.length();
+    int n = secB.length();
+
+    // FASE 1: Perfil de coincidencias
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    PerfilBits perfil;
+    construirPerfil(secA, perfil);
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // FASE 2: Distancia de edición
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    int distancia = distanciaConPerfil(perfil, m, secB);
+    int puntuacion = config.puntuacion.puntuacionDesdeDistancia(distancia, m, n);
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    ResultadoAlineamiento resultado("", "", puntuacion, tiempo_fase2_ms, 0.0, tiempo_fase1_ms);
+    resultado.solo_puntuacion = true;
+    return resultado;
+}
+
+ResultadoAlineamiento alineamientoNWBitParalelo(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+
+    if (!config.puntuacion.equivalenteDistanciaEdicion()) {
+        return AlgNW(secA, secB, config);
+    }
+    int m = secA.length();
+    int n = secB.length();
+
+    // FASE 1: Perfil de coincidencias
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    PerfilBits perfil;
+    construirPerfil(secA, perfil);
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // FASE 2: Distancia de edición; luego la banda completa su propia fase 2
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    int d = distanciaConPerfil(perfil, m, secB);
+    int puntuacion = config.puntuacion.puntuacionDesdeDistancia(d, m, n);
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    // Banda que contiene todos los caminos de coste <= d
+    int holgura = (d - std::abs(n - m)) / 2;
+    int diag_min = std::min(0, n - m) - holgura;
+    int diag_max = std::max(0, n - m) + holgura;
+    ResultadoAlineamiento resultado = alineamientoNWBanda(secA, secB, config, diag_min, diag_max);
+
+    if (resultado.puntuacion != puntuacion) {
+        std::cerr << "Error: la puntuación en banda (" << resultado.puntuacion
+                  << ") no coincide con la bit-paralela (" << puntuacion << ")\n";
+    }
+    resultado.tiempo_fase1_ms += tiempo_fase1_ms;
+    resultado.tiempo_fase2_ms += tiempo_fase2_ms;
+    return resultado;
+}
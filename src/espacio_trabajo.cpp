@@ -0,0 +1,46 @@
+#include "espacio_trabajo.h"
+#include <new>
+
+EspacioTrabajo::EspacioTrabajo() : matriz_sin_tocar_(false), contadores_(nullptr), bytes_contadores_(0) {}
+
+EspacioTrabajo::~EspacioTrabajo() {
+    liberarAlineado(contadores_);
+}
+
+MatrizDP& EspacioTrabajo::matriz(int filas, int columnas, DisposicionMatriz disposicion, int tam_bloque,
+                                 bool paginas_grandes) {
+    matriz_sin_tocar_ = matriz_.redimensionar(filas, columnas, disposicion, tam_bloque, paginas_grandes);
+    return matriz_;
+}
+
+MatrizEstadosAfin& EspacioTrabajo::estadosAfin(int filas, int columnas, DisposicionMatriz disposicion) {
+    estados_afin_.redimensionar(filas, columnas, disposicion);
+    return estados_afin_;
+}
+
+MatrizDirecciones& EspacioTrabajo::direcciones(int filas, int columnas) {
+    direcciones_.redimensionar(filas, columnas);
+    return direcciones_;
+}
+
+void* EspacioTrabajo::contadores(std::size_t bytes) {
+    if (bytes > bytes_contadores_ || contadores_ == nullptr) {
+        liberarAlineado(contadores_);
+        bytes_contadores_ = 0;
+        contadores_ = reservarAlineado(MatrizDP::ALINEACION_BYTES, bytes);
+        if (contadores_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        bytes_contadores_ = bytes;
+    }
+    return contadores_;
+}
+
+std::size_t EspacioTrabajo::bytes() const {
+    return codA.capacity() + codB.capacity() + pasos.capacity()
+         + (perfil.capacity() + anterior.capacity() + actual.capacity() + auxiliar.capacity()
+            + gaps.capacity()) * sizeof(int)
+         + testigos.capacity()
+         + matriz_.reservado() * sizeof(int) + direcciones_.reservado() + estados_afin_.reservado()
+         + bytes_contadores_;
+}
@@ -0,0 +1,250 @@
+#include "fasta_mapeado.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Por debajo de este tamaño por trozo la búsqueda de cabeceras no se reparte
+static const std::size_t BYTES_MINIMOS_TROZO = 1 << 20;
+
+enum ClaseSimbolo { SIMBOLO_INVALIDO = 0, SIMBOLO_BASE = 1, SIMBOLO_SALTO = 2 };
+
+/**
+ * @brief Tabla byte -> clase: base (código IUPAC en cualquier caja o '-'),
+ *        salto de línea ('\n', '\r') o inválido.
+ */
+struct TablaClasesFASTA {
+    unsigned char clase[256];
+
+    TablaClasesFASTA() {
+        std::memset(clase, SIMBOLO_INVALIDO, sizeof(clase));
+        for (const char* c = "ACGTURYSWKMBDHVN"; *c != '\0'; ++c) {
+            clase[static_cast<unsigned char>(*c)] = SIMBOLO_BASE;
+            clase[static_cast<unsigned char>(*c - 'A' + 'a')] = SIMBOLO_BASE;
+        }
+        clase[static_cast<unsigned char>('-')] = SIMBOLO_BASE;
+        clase[static_cast<unsigned char>('\n')] = SIMBOLO_SALTO;
+        clase[static_cast<unsigned char>('\r')] = SIMBOLO_SALTO;
+    }
+};
+
+static const TablaClasesFASTA TABLA_CLASES;
+
+/**
+ * @brief Cuenta bases y símbolos inválidos de [p, p + n).
+ *
+ * Con GCC/Clang recorre bloques de hasta 255 vectores de 16 bytes: los
+ * saltos de línea se acumulan por carril (un byte por carril no desborda
+ * en 255 vectores) y cualquier símbolo distinto de ACGTN (en cualquier
+ * caja) o salto marca el bloque, que entonces se revisa byte a byte con la
+ * tabla. Un FASTA normal no sale nunca del camino vectorial.
+ */
+static void escanearBases(const char* p, std::size_t n, std::size_t& bases, std::size_t& invalidas,
+                          bool& retornos) {
+    std::size_t saltos = 0;
+    std::size_t malas = 0;
+    std::size_t cr = 0;
+    std::size_t k = 0;
+#if defined(__GNUC__)
+    typedef unsigned char v16qu __attribute__((vector_size(16)));
+    while (k + 16 <= n) {
+        std::size_t inicio = k;
+        std::size_t vectores = std::min<std::size_t>((n - k) / 16, 255);
+        v16qu cuenta = {0};
+        v16qu cuenta_cr = {0};
+        v16qu raros = {0};
+        for (std::size_t v = 0; v < vectores; ++v, k += 16) {
+            v16qu x;
+            std::memcpy(&x, p + k, 16);
+            v16qu mayuscula = x & 0xDF;
+            v16qu retorno = (v16qu)(x == '\r');
+            v16qu salto = (v16qu)(x == '\n') | retorno;
+            v16qu acgtn = (v16qu)(mayuscula == 'A') | (v16qu)(mayuscula == 'C') | (v16qu)(mayuscula == 'G')
+                        | (v16qu)(mayuscula == 'T') | (v16qu)(mayuscula == 'N');
+            cuenta -= salto;   // salto vale 0xFF (= -1) en los carriles con salto
+            cuenta_cr -= retorno;
+            raros |= ~(salto | acgtn);
+        }
+        for (int c = 0; c < 16; ++c) {
+            saltos += cuenta[c];
+            cr += cuenta_cr[c];
+        }
+        std::uint64_t r[2];
+        std::memcpy(r, &raros, 16);
+        if ((r[0] | r[1]) != 0) {
+            for (std::size_t j = inicio; j < k; ++j) {
+                malas += TABLA_CLASES.clase[static_cast<unsigned char>(p[j])] == SIMBOLO_INVALIDO;
+            }
+        }
+    }
+#endif
+    for (; k < n; ++k) {
+        unsigned char clase = TABLA_CLASES.clase[static_cast<unsigned char>(p[k])];
+        saltos += (clase == SIMBOLO_SALTO);
+        malas += (clase == SIMBOLO_INVALIDO);
+        cr += (p[k] == '\r');
+    }
+    bases = n - saltos;
+    invalidas = malas;
+    retornos = (cr != 0);
+}
+
+ArchivoFastaMapeado::ArchivoFastaMapeado(const std::string& nombreArchivo)
+    : archivo_(nombreArchivo, true), datos_(archivo_.datos()), tamano_(archivo_.tamano()) {
+    if (!archivo_.abierto()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << "\n";
+        return;
+    }
+    indexar();
+
+    std::size_t total_invalidas = invalidas();
+    if (total_invalidas > 0) {
+        std::cerr << "Aviso: " << nombreArchivo << " contiene " << total_invalidas
+                  << " simbolos que no son IUPAC (se conservan tal cual)\n";
+    }
+}
+
+void ArchivoFastaMapeado::indexar() {
+    const char* d = datos_;
+    std::size_t n = tamano_;
+
+    // 1. Cabeceras: '>' al principio de línea, buscadas por trozos en paralelo
+    int trozos = 1;
+#ifdef _OPENMP
+    trozos = omp_get_max_threads();
+#endif
+    if (n / BYTES_MINIMOS_TROZO < static_cast<std::size_t>(trozos)) {
+        trozos = static_cast<int>(std::max<std::size_t>(1, n / BYTES_MINIMOS_TROZO));
+    }
+    std::vector<std::vector<std::size_t> > cabeceras_trozo(trozos);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int t = 0; t < trozos; ++t) {
+        std::size_t fin = n * (t + 1) / trozos;
+        const char* p = d + n * t / trozos;
+        while (p < d + fin) {
+            const char* mayor = static_cast<const char*>(std::memchr(p, '>', d + fin - p));
+            if (mayor == nullptr) break;
+            std::size_t posicion = mayor - d;
+            if (posicion == 0 || d[posicion - 1] == '\n') {
+                cabeceras_trozo[t].push_back(posicion);
+            }
+            p = mayor + 1;
+        }
+    }
+
+    // 2. Registros: lo anterior a la primera cabecera es un registro sin nombre
+    std::vector<Registro> candidatos;
+    std::size_t primera = n;
+    for (const std::vector<std::size_t>& cabeceras : cabeceras_trozo) {
+        if (!cabeceras.empty()) {
+            primera = cabeceras.front();
+            break;
+        }
+    }
+    if (primera > 0) {
+        candidatos.push_back({0, 0, primera, 0, 0, false});
+    }
+    for (const std::vector<std::size_t>& cabeceras : cabeceras_trozo) {
+        for (std::size_t inicio : cabeceras) {
+            if (!candidatos.empty()) {
+                candidatos.back().fin = inicio;
+            }
+            const char* salto = static_cast<const char*>(std::memchr(d + inicio, '\n', n - inicio));
+            std::size_t datos = (salto != nullptr) ? static_cast<std::size_t>(salto - d) + 1 : n;
+            candidatos.push_back({inicio, datos, n, 0, 0, false});
+        }
+    }
+
+    // 3. Bases y símbolos inválidos de cada registro
+    long long num_candidatos = static_cast<long long>(candidatos.size());
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long long r = 0; r < num_candidatos; ++r) {
+        Registro& registro = candidatos[r];
+        escanearBases(d + registro.datos, registro.fin - registro.datos, registro.bases, registro.invalidas,
+                      registro.retornos);
+    }
+
+    for (const Registro& registro : candidatos) {
+        if (registro.bases > 0) {
+            registros_.push_back(registro);
+        }
+    }
+}
+
+std::string ArchivoFastaMapeado::cabecera(std::size_t r) const {
+    const Registro& registro = registros_[r];
+    if (registro.datos == registro.cabecera) {
+        return "";
+    }
+    std::size_t fin = registro.datos;
+    while (fin > registro.cabecera + 1 && (datos_[fin - 1] == '\n' || datos_[fin - 1] == '\r')) {
+        --fin;
+    }
+    return std::string(datos_ + registro.cabecera + 1, datos_ + fin);
+}
+
+std::size_t ArchivoFastaMapeado::invalidas() const {
+    std::size_t total = 0;
+    for (const Registro& registro : registros_) {
+        total += registro.invalidas;
+    }
+    return total;
+}
+
+template <typename Funcion>
+void ArchivoFastaMapeado::recorrerTramos(std::size_t r, Funcion f) const {
+    const char* p = datos_ + registros_[r].datos;
+    const char* fin = datos_ + registros_[r].fin;
+    bool retornos = registros_[r].retornos;
+    while (p < fin) {
+        const char* salto = static_cast<const char*>(std::memchr(p, '\n', fin - p));
+        const char* fin_linea = (salto != nullptr) ? salto : fin;
+        if (!retornos) {
+            if (fin_linea > p) {
+                f(p, static_cast<std::size_t>(fin_linea - p));
+            }
+            p = fin_linea + 1;
+            continue;
+        }
+        // Un '\r' (fin de línea CRLF) corta el tramo igual que '\n'
+        while (p < fin_linea) {
+            const char* retorno = static_cast<const char*>(std::memchr(p, '\r', fin_linea - p));
+            const char* fin_tramo = (retorno != nullptr) ? retorno : fin_linea;
+            if (fin_tramo > p) {
+                f(p, static_cast<std::size_t>(fin_tramo - p));
+            }
+            p = (retorno != nullptr) ? retorno + 1 : fin_linea;
+        }
+        p = fin_linea + 1;
+    }
+}
+
+void ArchivoFastaMapeado::copiarBases(std::size_t r, char* destino) const {
+    recorrerTramos(r, [&destino](const char* tramo, std::size_t longitud) {
+        std::memcpy(destino, tramo, longitud);
+        destino += longitud;
+    });
+}
+
+std::string ArchivoFastaMapeado::secuencia(std::size_t r) const {
+    std::string resultado(longitud(r), '\0');
+    copiarBases(r, &resultado[0]);
+    return resultado;
+}
+
+SecuenciaDNA ArchivoFastaMapeado::empaquetar(std::size_t r) const {
+    SecuenciaDNA resultado;
+    resultado.reservar(longitud(r));
+    recorrerTramos(r, [&resultado](const char* tramo, std::size_t longitud) {
+        resultado.anadir(tramo, longitud);
+    });
+    return resultado;
+}
@@ -1,4 +1,6 @@
 #include "generador_secuencias.h"
+#include "fasta_mapeado.h"
+#include "secuencias_binarias.h"
 #include <random>
 #include <algorithm>
 #include <fstream>
@@ -98,6 +100,14 @@ double calcularSimilitudDNA(const std::string& sec1, const std::string& sec2) {
     return static_cast<double>(coincidencias) / sec1.length();
 }
 
+double calcularSimilitudDNA(const SecuenciaDNA& sec1, const SecuenciaDNA& sec2) {
+    if (sec1.longitud() != sec2.longitud() || sec1.vacia()) {
+        return 0.0;
+    }
+    
+    return static_cast<double>(contarCoincidenciasPosicionales(sec1, sec2)) / sec1.longitud();
+}
+
 ParSecuenciasDNA generarParSecuenciasDNA(int longitud, 
                                          double similitud_objetivo) {
     ParSecuenciasDNA par;
@@ -135,7 +145,23 @@ static std::string formatearSecuenciaFASTA(const std::string& sec, int ancho_lin
 bool guardarParSecuenciasDNAFASTA(const ParSecuenciasDNA& par, 
                                   const std::string& nombreArchivo,
                                   const std::string& id_sec1,
-                                  const std::string& id_sec2) {
+                                  const std::string& id_sec2,
+                                  FormatoSecuencias formato) {
+    std::ostringstream cabecera1;
+    cabecera1 << id_sec1 << " longitud=" << par.sec1.length() << " tipo=DNA";
+    std::ostringstream cabecera2;
+    cabecera2 << id_sec2 << " longitud=" << par.sec2.length() 
+              << " tipo=DNA similitud=" << std::fixed << std::setprecision(4) 
+              << par.similitud_real;
+    
+    if (formato == FORMATO_BINARIO) {
+        EscritorSecuenciasBinarias escritor(nombreArchivo);
+        return escritor.abierto()
+            && escritor.anadir(cabecera1.str(), SecuenciaDNA(par.sec1))
+            && escritor.anadir(cabecera2.str(), SecuenciaDNA(par.sec2))
+            && escritor.cerrar();
+    }
+    
     std::ofstream archivo(nombreArchivo);
     
     if (!archivo.is_open()) {
@@ -144,67 +170,98 @@ bool guardarParSecuenciasDNAFASTA(const ParSecuenciasDNA& par,
     }
     
     // Primera secuencia
-    archivo << ">" << id_sec1 << " longitud=" << par.sec1.length() 
-            << " tipo=DNA\n";
+    archivo << ">" << cabecera1.str() << "\n";
     archivo << formatearSecuenciaFASTA(par.sec1);
     
     // Segunda secuencia
-    archivo << ">" << id_sec2 << " longitud=" << par.sec2.length() 
-            << " tipo=DNA similitud=" << std::fixed << std::setprecision(4) 
-            << par.similitud_real << "\n";
+    archivo << ">" << cabecera2.str() << "\n";
     archivo << formatearSecuenciaFASTA(par.sec2);
     
     archivo.close();
     return true;
 }
 
+/**
+ * @brief Lee "similitud=<valor>" de una cabecera FASTA; false si no aparece.
+ */
+static bool leerSimilitudCabecera(const std::string& cabecera, double& similitud) {
+    size_t pos = cabecera.find("similitud=");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    similitud = std::stod(cabecera.substr(pos + 10));
+    return true;
+}
+
 ParSecuenciasDNA cargarParSecuenciasDNAFASTA(const std::string& nombreArchivo) {
-    std::ifstream archivo(nombreArchivo);
     ParSecuenciasDNA par;
     
-    if (!archivo.is_open()) {
-        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << "\n";
+    if (esArchivoSecuenciasBinario(nombreArchivo)) {
+        ArchivoSecuenciasBinario binario(nombreArchivo);
+        for (size_t r = 0; r < 2 && r < binario.registros(); ++r) {
+            (r == 0 ? par.sec1 : par.sec2) = binario.texto(r);
+            leerSimilitudCabecera(binario.cabecera(r), par.similitud_real);
+        }
         return par;
     }
     
-    std::string linea;
-    std::string secuencia_actual;
-    int contador_sec = 0;
+    ArchivoFastaMapeado archivo(nombreArchivo);
     
-    while (std::getline(archivo, linea)) {
-        if (linea.empty()) continue;
-        
-        if (linea[0] == '>') {
-            // Cabecera de secuencia
-            if (contador_sec == 1) {
-                par.sec1 = secuencia_actual;
-                secuencia_actual.clear();
-            }
-            
-            // Parsear información de la cabecera
-            if (linea.find("similitud=") != std::string::npos) {
-                size_t pos = linea.find("similitud=") + 10;
-                par.similitud_real = std::stod(linea.substr(pos));
-            }
-            
-            contador_sec++;
-        } else {
-            // Línea de secuencia
-            secuencia_actual += linea;
+    if (archivo.registros() > 0) {
+        par.sec1 = archivo.secuencia(0);
+        leerSimilitudCabecera(archivo.cabecera(0), par.similitud_real);
+    }
+    if (archivo.registros() > 1) {
+        par.sec2 = archivo.secuencia(1);
+        leerSimilitudCabecera(archivo.cabecera(1), par.similitud_real);
+    }
+    return par;
+}
+
+ParSecuenciasDNAEmpaquetado cargarParSecuenciasDNAFASTAEmpaquetado(const std::string& nombreArchivo) {
+    ParSecuenciasDNAEmpaquetado par;
+    
+    if (esArchivoSecuenciasBinario(nombreArchivo)) {
+        // Las palabras ya están empaquetadas: solo se copian
+        ArchivoSecuenciasBinario binario(nombreArchivo);
+        bool similitud_en_cabecera = false;
+        for (size_t r = 0; r < 2 && r < binario.registros(); ++r) {
+            similitud_en_cabecera |= leerSimilitudCabecera(binario.cabecera(r), par.similitud_real);
+            (r == 0 ? par.sec1 : par.sec2) = binario.secuencia(r);
+        }
+        if (!similitud_en_cabecera) {
+            par.similitud_real = calcularSimilitudDNA(par.sec1, par.sec2);
         }
+        return par;
     }
     
-    if (contador_sec == 2) {
-        par.sec2 = secuencia_actual;
+    ArchivoFastaMapeado archivo(nombreArchivo);
+    
+    if (!archivo.abierto()) {
+        return par;
     }
     
-    archivo.close();
+    bool similitud_en_cabecera = false;
+    for (size_t r = 0; r < 2 && r < archivo.registros(); ++r) {
+        similitud_en_cabecera |= leerSimilitudCabecera(archivo.cabecera(r), par.similitud_real);
+    }
+    if (archivo.registros() > 0) {
+        par.sec1 = archivo.empaquetar(0);
+    }
+    if (archivo.registros() > 1) {
+        par.sec2 = archivo.empaquetar(1);
+    }
+    
+    if (!similitud_en_cabecera) {
+        par.similitud_real = calcularSimilitudDNA(par.sec1, par.sec2);
+    }
     return par;
 }
 
 int generarLoteSecuenciasDNA(const std::string& directorio_base,
                              const std::vector<int>& longitudes,
-                             const std::vector<double>& similitudes) {
+                             const std::vector<double>& similitudes,
+                             FormatoSecuencias formato) {
     // Crear directorio base si no existe
     if (!crearDirectorio(directorio_base)) {
         std::cerr << "Error: No se pudo crear el directorio " << directorio_base << "\n";
@@ -223,10 +280,11 @@ int generarLoteSecuenciasDNA(const std::string& directorio_base,
             std::ostringstream nombre_archivo;
             nombre_archivo << directorio_base << "/"
                           << "dna_lon" << longitud
-                          << "_sim" << static_cast<int>(similitud * 100) << ".fasta";
+                          << "_sim" << static_cast<int>(similitud * 100)
+                          << (formato == FORMATO_BINARIO ? ".nwb" : ".fasta");
             
             // Guardar
-            if (guardarParSecuenciasDNAFASTA(par, nombre_archivo.str())) {
+            if (guardarParSecuenciasDNAFASTA(par, nombre_archivo.str(), "sec1", "sec2", formato)) {
                 archivos_generados++;
                 std::cout << "Generado: " << nombre_archivo.str() 
                          << " (similitud real: " << std::fixed << std::setprecision(4) 
@@ -0,0 +1,244 @@
+#include "hirschberg.h"
+#include "puntuacion.h"
+#include "traceback.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <omp.h>
+
+// Soporte para eventos de Extrae (opcional)
+#ifdef HAVE_EXTRAE
+#include <extrae.h>
+#endif
+
+// Subproblemas con menos celdas se resuelven sin crear tareas nuevas
+static const long long UMBRAL_CELDAS_TAREA = 1LL << 16;
+
+/**
+ * @brief Última fila DP de a[0..la) frente a b[0..lb) (o de ambas invertidas).
+ *
+ * fila[k] queda con la puntuación óptima de alinear todo el tramo de A con los
+ * primeros k caracteres de B. Con INVERTIDO = true ambos tramos se recorren
+ * de atrás hacia adelante, de modo que fila[k] corresponde al sufijo de
+ * longitud k de B. Usa una sola fila de lb + 1 enteros. a y b vienen ya
+ * codificadas (codificarIUPAC).
+ */
+template <bool INVERTIDO>
+static void calcularUltimaFila(const char* a, int la, const char* b, int lb,
+                               const TablaSustitucionDNA& tabla,
+                               int penalidadGap, int* fila) {
+    fila[0] = 0;
+    for (int k = 1; k <= lb; ++k) {
+        fila[k] = fila[k-1] + penalidadGap;
+    }
+    for (int i = 1; i <= la; ++i) {
+        const int* fila_tabla = tabla.fila(INVERTIDO ? a[la - i] : a[i-1]);
+        int diagonal = fila[0];
+        fila[0] = diagonal + penalidadGap;
+        for (int k = 1; k <= lb; ++k) {
+            int coincidencia = diagonal + fila_tabla[static_cast<unsigned char>(INVERTIDO ? b[lb - k] : b[k-1])];
+            int eliminacion = fila[k] + penalidadGap;
+            int insercion = fila[k-1] + penalidadGap;
+            diagonal = fila[k];
+            fila[k] = std::max({coincidencia, eliminacion, insercion});
+        }
+    }
+}
+
+/**
+ * @brief Fija cortes[i] para las fronteras i0 < i < i1 del subproblema.
+ *
+ * El subproblema es A[i0..i1) frente a B[j0..j1); cortes[i0] y cortes[i1]
+ * ya están fijados por el llamador.
+ */
+static void dividirHirschberg(const char* secA, const char* secB,
+                              int i0, int i1, int j0, int j1,
+                              const TablaSustitucionDNA* tabla,
+                              int penalidadGap, int* cortes) {
+    if (i1 - i0 <= 1) {
+        return;
+    }
+    if (j1 == j0) {
+        // Sin columnas: todo el tramo de A son eliminaciones
+        for (int i = i0 + 1; i < i1; ++i) {
+            cortes[i] = j0;
+        }
+        return;
+    }
+
+    int medio = i0 + (i1 - i0) / 2;
+    int n = j1 - j0;
+    bool en_paralelo = static_cast<long long>(i1 - i0) * n > UMBRAL_CELDAS_TAREA;
+
+    // Las filas se liberan antes de los subproblemas: así solo las tiene
+    // vivas el nivel que las usa y la memoria es O(m + n), no O(n log m)
+    int corte;
+    {
+        std::vector<int> adelante(n + 1);
+        std::vector<int> atras(n + 1);
+        int* p_adelante = adelante.data();
+        int* p_atras = atras.data();
+
+        #pragma omp task if(en_paralelo) \
+            firstprivate(secA, secB, i0, medio, j0, n, tabla, penalidadGap, p_adelante)
+        calcularUltimaFila<false>(secA + i0, medio - i0, secB + j0, n,
+                                  *tabla, penalidadGap, p_adelante);
+        calcularUltimaFila<true>(secA + medio, i1 - medio, secB + j0, n,
+                                 *tabla, penalidadGap, p_atras);
+        #pragma omp taskwait
+
+        // Columna de corte: maximiza prefijo superior + sufijo inferior
+        int mejor_k = 0;
+        int mejor = adelante[0] + atras[n];
+        for (int k = 1; k <= n; ++k) {
+            int valor = adelante[k] + atras[n - k];
+            if (valor > mejor) {
+                mejor = valor;
+                mejor_k = k;
+            }
+        }
+        corte = j0 + mejor_k;
+    }
+    cortes[medio] = corte;
+
+    // Los dos subproblemas escriben en rangos disjuntos de cortes
+    #pragma omp task if(en_paralelo) \
+        firstprivate(secA, secB, i0, medio, j0, corte, tabla, penalidadGap, cortes)
+    dividirHirschberg(secA, secB, i0, medio, j0, corte, tabla, penalidadGap, cortes);
+    dividirHirschberg(secA, secB, medio, i1, corte, j1, tabla, penalidadGap, cortes);
+    #pragma omp taskwait
+}
+
+/**
+ * @brief Alineamiento paralelo en espacio lineal (Hirschberg)
+ *
+ * La fase 2 (divide y vencerás) usa tareas OpenMP; la fase 3 ensambla cada
+ * fila con un parallel for sobre el buffer de salida ya dimensionado.
+ *
+ * @param secA Secuencia A (DNA)
+ * @param secB Secuencia B (DNA)
+ * @param config Configuración de alineamiento
+ * @return ResultadoAlineamiento con alineamiento, puntuación y tiempos
+ */
+ResultadoAlineamiento alineamientoNWHirschberg(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+
+    int m = secA.length();
+    int n = secB.length();
+
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    // Cada nivel de la recursión vuelve a recorrer las secuencias: se codifican una vez
+    TablaSustitucionDNA tabla(config.puntuacion);
+    std::string codA = codificarIUPAC(secA);
+    std::string codB = codificarIUPAC(secB);
+    // cortes[i]: columna por la que el camino óptimo cruza la frontera de la fila i
+    std::vector<int> cortes(m + 1, 0);
+    cortes[m] = n;
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // FASE 2: Divide y vencerás
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    const char* pA = codA.data();
+    const char* pB = codB.data();
+    const TablaSustitucionDNA* p_tabla = &tabla;
+    int* p_cortes = cortes.data();
+    #pragma omp parallel
+    {
+        #pragma omp single
+        dividirHirschberg(pA, pB, 0, m, 0, n, p_tabla, penalidadGap, p_cortes);
+    }
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    // FASE 3: Ensamblado del alineamiento
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    // Cada fila i alinea secA[i-1] con secB[cortes[i-1]..cortes[i]): o bien
+    // empareja el carácter con una posición del tramo, o bien lo elimina.
+    std::vector<int> emparejado(m, -1);
+    std::vector<size_t> desplazamiento(m + 1, 0);
+    int puntuacion_total = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:puntuacion_total)
+    for (int i = 1; i <= m; ++i) {
+        int k0 = cortes[i-1];
+        int k1 = cortes[i];
+        int tramo = k1 - k0;
+        int mejor = tramo * penalidadGap + penalidadGap;  // eliminación + inserciones
+        int posicion = -1;
+        for (int k = k0; k < k1; ++k) {
+            int valor = (tramo - 1) * penalidadGap
+                      + tabla(codA[i-1], codB[k]);
+            if (valor > mejor) {
+                mejor = valor;
+                posicion = k;
+            }
+        }
+        emparejado[i-1] = posicion;
+        desplazamiento[i] = (posicion >= 0) ? tramo : tramo + 1;
+        puntuacion_total += mejor;
+    }
+    if (m == 0) {
+        puntuacion_total = n * penalidadGap;
+        desplazamiento[0] = n;
+    }
+    for (int i = 1; i <= m; ++i) {
+        desplazamiento[i] += desplazamiento[i-1];
+    }
+
+    std::string alineadaA(desplazamiento[m], '-');
+    std::string alineadaB(desplazamiento[m], '-');
+    if (m == 0) {
+        alineadaB = secB;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 1; i <= m; ++i) {
+        size_t pos = desplazamiento[i-1];
+        int posicion = emparejado[i-1];
+        for (int k = cortes[i-1]; k < cortes[i]; ++k) {
+            if (k == posicion) {
+                alineadaA[pos] = secA[i-1];
+            }
+            alineadaB[pos++] = secB[k];
+        }
+        if (posicion < 0) {
+            alineadaA[pos] = secA[i-1];
+        }
+    }
+
+    // La salida compacta se deriva del alineamiento ya ensamblado
+    std::string cigar;
+    if (config.salida_cigar) {
+        cigar = cigarDesdeAlineamiento(alineadaA, alineadaB);
+        alineadaA.clear();
+        alineadaB.clear();
+    }
+
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion_total, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
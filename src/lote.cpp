@@ -0,0 +1,388 @@
+#include "lote.h"
+#include "secuencial.h"
+#include "afin.h"
+#include "puntuacion.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <omp.h>
+#include <queue>
+
+// Soporte para eventos de Extrae (opcional)
+#ifdef HAVE_EXTRAE
+#include <extrae.h>
+#endif
+
+// Tramos por thread en cada cubeta: suficientes para repartir la cola
+static const std::size_t TRAMOS_POR_THREAD = 4;
+
+// Dianas que toma un thread de una vez en buscarEnBaseDatos
+static const int TRAMO_BUSQUEDA = 8;
+
+// Bases de un bloque de teselas que deben caber en caché (L2 típica)
+static const std::size_t BASES_BLOQUE_CACHE = 128 * 1024;
+
+std::vector<ParLote> paresConsecutivos(std::size_t num_secuencias) {
+    std::vector<ParLote> pares;
+    pares.reserve(num_secuencias / 2);
+    for (std::size_t k = 0; k + 1 < num_secuencias; k += 2) {
+        pares.push_back({k, k + 1});
+    }
+    return pares;
+}
+
+const char* nombrePlanificacionLote(PlanificacionLote planificacion) {
+    return (planificacion == LOTE_CUBETAS) ? "cubetas" : "mas_largo_primero";
+}
+
+/**
+ * @brief Cubeta de un coste: 0 para 0, si no 1 + floor(log2(coste)).
+ */
+static int cubetaCoste(std::size_t coste) {
+    int cubeta = 0;
+    while (coste != 0) {
+        ++cubeta;
+        coste >>= 1;
+    }
+    return cubeta;
+}
+
+/**
+ * @brief Orden de los pares y tramos que se reparten entre threads.
+ *
+ * El tramo k abarca orden[inicio_tramo[k], inicio_tramo[k + 1]).
+ */
+static void planificarPares(const std::vector<std::size_t>& costes, PlanificacionLote planificacion,
+                            int threads, std::vector<std::size_t>& orden,
+                            std::vector<std::size_t>& inicio_tramo) {
+    std::size_t total = costes.size();
+    orden.resize(total);
+    inicio_tramo.clear();
+
+    if (planificacion == LOTE_MAS_LARGO_PRIMERO) {
+        for (std::size_t p = 0; p < total; ++p) {
+            orden[p] = p;
+        }
+        std::stable_sort(orden.begin(), orden.end(), [&](std::size_t x, std::size_t y) {
+            return costes[x] > costes[y];
+        });
+        for (std::size_t p = 0; p <= total; ++p) {
+            inicio_tramo.push_back(p);
+        }
+        return;
+    }
+
+    // Ordenación por cuentas: cubetas de mayor a menor, orden de entrada dentro de cada una
+    const int NUM_CUBETAS = 65;
+    std::vector<std::size_t> cuenta(NUM_CUBETAS, 0);
+    for (std::size_t c : costes) {
+        ++cuenta[cubetaCoste(c)];
+    }
+    std::vector<std::size_t> posicion(NUM_CUBETAS, 0);
+    std::size_t acumulado = 0;
+    for (int b = NUM_CUBETAS - 1; b >= 0; --b) {
+        posicion[b] = acumulado;
+        acumulado += cuenta[b];
+    }
+    for (std::size_t p = 0; p < total; ++p) {
+        orden[posicion[cubetaCoste(costes[p])]++] = p;
+    }
+
+    std::size_t inicio = 0;
+    for (int b = NUM_CUBETAS - 1; b >= 0; --b) {
+        if (cuenta[b] == 0) continue;
+        std::size_t tam = std::max<std::size_t>(1, cuenta[b] / (TRAMOS_POR_THREAD * threads));
+        for (std::size_t k = 0; k < cuenta[b]; k += tam) {
+            inicio_tramo.push_back(inicio + k);
+        }
+        inicio += cuenta[b];
+    }
+    inicio_tramo.push_back(total);
+}
+
+ResultadoAlineamiento alinearPar(const std::string& secA, const std::string& secB,
+                                 const ConfiguracionAlineamiento& config, bool solo_puntuacion,
+                                 EspacioTrabajo& espacio) {
+    if (config.puntuacion.gapAfin()) {
+        return solo_puntuacion ? puntuacionNWAfin(secA, secB, config, espacio)
+                               : alineamientoNWAfin(secA, secB, config, espacio);
+    }
+    return solo_puntuacion ? puntuacionNW(secA, secB, config, espacio) : AlgNW(secA, secB, config, espacio);
+}
+
+ResultadoLote alinearLote(const std::vector<std::string>& secuencias,
+                          const std::vector<ParLote>& pares,
+                          const ConfiguracionAlineamiento& config,
+                          const OpcionesLote& opciones) {
+    ResultadoLote lote;
+    for (const ParLote& par : pares) {
+        if (par.a >= secuencias.size() || par.b >= secuencias.size()) {
+            std::cerr << "Error: par (" << par.a << ", " << par.b << ") fuera de rango ("
+                      << secuencias.size() << " secuencias)\n";
+            return lote;
+        }
+    }
+
+    auto t_inicio = std::chrono::high_resolution_clock::now();
+    int threads = (opciones.threads > 0) ? opciones.threads : omp_get_max_threads();
+    std::vector<std::size_t> costes(pares.size());
+    for (std::size_t p = 0; p < pares.size(); ++p) {
+        costes[p] = secuencias[pares[p].a].size() * secuencias[pares[p].b].size();
+        lote.celdas += costes[p];
+    }
+    std::vector<std::size_t> orden;
+    std::vector<std::size_t> inicio_tramo;
+    planificarPares(costes, opciones.planificacion, threads, orden, inicio_tramo);
+    lote.resultados.resize(pares.size());
+    lote.thread.assign(pares.size(), 0);
+    long long num_tramos = static_cast<long long>(inicio_tramo.size()) - 1;
+
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    #pragma omp parallel num_threads(threads)
+    {
+        // Buffers privados del thread, reutilizados en todos sus pares
+        EspacioTrabajo espacio;
+        int id = omp_get_thread_num();
+        #pragma omp for schedule(dynamic, 1)
+        for (long long k = 0; k < num_tramos; ++k) {
+            for (std::size_t q = inicio_tramo[k]; q < inicio_tramo[k + 1]; ++q) {
+                std::size_t p = orden[q];
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, static_cast<long long>(p) + 1);
+#endif
+                lote.resultados[p] = alinearPar(secuencias[pares[p].a], secuencias[pares[p].b],
+                                                config, opciones.solo_puntuacion, espacio);
+                lote.thread[p] = id;
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, 0);
+#endif
+            }
+        }
+        #pragma omp single
+        lote.threads = omp_get_num_threads();
+    }
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    auto t_fin = std::chrono::high_resolution_clock::now();
+    lote.tiempo_total_ms = std::chrono::duration<double, std::milli>(t_fin - t_inicio).count();
+    return lote;
+}
+
+/**
+ * @brief Secuencias por bloque: el bloque cabe en BASES_BLOQUE_CACHE y hay al
+ *        menos TRAMOS_POR_THREAD teselas por thread (si N lo permite).
+ */
+static std::size_t tamanoBloqueTodos(std::size_t num_secuencias, std::size_t total_bases, int threads) {
+    std::size_t longitud_media = std::max<std::size_t>(1, total_bases / num_secuencias);
+    std::size_t tam = std::max<std::size_t>(1, std::min(num_secuencias, BASES_BLOQUE_CACHE / longitud_media));
+    while (tam > 1) {
+        std::size_t bloques = (num_secuencias + tam - 1) / tam;
+        if (bloques * (bloques + 1) / 2 >= TRAMOS_POR_THREAD * threads) break;
+        tam /= 2;
+    }
+    return tam;
+}
+
+ResultadoTodosContraTodos puntuacionesTodosContraTodos(const std::vector<std::string>& secuencias,
+                                                       const ConfiguracionAlineamiento& config,
+                                                       std::size_t tam_bloque, int threads) {
+    ResultadoTodosContraTodos todos;
+    std::size_t n = secuencias.size();
+    todos.puntuaciones = MatrizPuntuaciones(n);
+    if (n == 0) {
+        return todos;
+    }
+
+    auto t_inicio = std::chrono::high_resolution_clock::now();
+    if (threads <= 0) {
+        threads = omp_get_max_threads();
+    }
+    bool afin = config.puntuacion.gapAfin();
+    // Con gap afín el perfil de consulta es siempre necesario
+    bool con_perfil = afin || detectarEsquemaFijo(config.puntuacion) == ESQUEMA_GENERICO;
+    TablaSustitucionDNA tabla(config.puntuacion);
+
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    // Cada secuencia se codifica una vez para todos sus pares
+    std::vector<std::string> codigos(n);
+    std::size_t total_bases = 0;
+    std::size_t suma_cuadrados = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        codificarIUPAC(secuencias[k], codigos[k]);
+        total_bases += secuencias[k].size();
+        suma_cuadrados += secuencias[k].size() * secuencias[k].size();
+    }
+    todos.celdas = (total_bases * total_bases + suma_cuadrados) / 2;
+    todos.pares = n * (n + 1) / 2;
+    todos.tam_bloque = (tam_bloque > 0) ? std::min(tam_bloque, n) : tamanoBloqueTodos(n, total_bases, threads);
+    std::size_t tam = todos.tam_bloque;
+    std::size_t num_bloques = (n + tam - 1) / tam;
+
+    // Teselas (I, J) con I <= J, de la más cara a la más barata
+    std::vector<std::size_t> bases_bloque(num_bloques, 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        bases_bloque[k / tam] += secuencias[k].size();
+    }
+    std::vector<ParLote> teselas;
+    std::vector<std::size_t> costes;
+    for (std::size_t I = 0; I < num_bloques; ++I) {
+        for (std::size_t J = I; J < num_bloques; ++J) {
+            teselas.push_back({I, J});
+            std::size_t coste = bases_bloque[I] * bases_bloque[J];
+            costes.push_back((I == J) ? coste / 2 : coste);
+        }
+    }
+    std::vector<std::size_t> orden;
+    std::vector<std::size_t> inicio_tramo;
+    planificarPares(costes, LOTE_MAS_LARGO_PRIMERO, threads, orden, inicio_tramo);
+    long long num_teselas = static_cast<long long>(teselas.size());
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    #pragma omp parallel num_threads(threads)
+    {
+        EspacioTrabajo espacio;
+        #pragma omp for schedule(dynamic, 1)
+        for (long long k = 0; k < num_teselas; ++k) {
+            const ParLote& tesela = teselas[orden[k]];
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, static_cast<long long>(orden[k]) + 1);
+#endif
+            std::size_t inicio_i = tesela.a * tam;
+            std::size_t fin_i = std::min(n, inicio_i + tam);
+            std::size_t inicio_j = tesela.b * tam;
+            std::size_t fin_j = std::min(n, inicio_j + tam);
+            for (std::size_t j = inicio_j; j < fin_j; ++j) {
+                if (con_perfil) {
+                    construirPerfilConsulta(codigos[j], tabla, espacio.perfil);
+                }
+                // En las teselas de la diagonal solo el triángulo i <= j
+                std::size_t limite_i = (tesela.a == tesela.b) ? j + 1 : fin_i;
+                for (std::size_t i = inicio_i; i < limite_i; ++i) {
+                    int puntuacion = afin
+                        ? puntuacionNWAfinCodificada(codigos[i], codigos[j], espacio.perfil, config, espacio)
+                        : puntuacionNWCodificada(codigos[i], codigos[j], espacio.perfil, config, espacio);
+                    todos.puntuaciones.fijar(i, j, puntuacion);
+                }
+            }
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, 0);
+#endif
+        }
+        #pragma omp single
+        todos.threads = omp_get_num_threads();
+    }
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    auto t_fin = std::chrono::high_resolution_clock::now();
+    todos.tiempo_total_ms = std::chrono::duration<double, std::milli>(t_fin - t_inicio).count();
+    return todos;
+}
+
+/** @brief Orden de las dianas: mayor puntuación primero y, a igualdad, menor índice. */
+static bool mejorAcierto(const AciertoBusqueda& x, const AciertoBusqueda& y) {
+    return (x.puntuacion != y.puntuacion) ? x.puntuacion > y.puntuacion : x.indice < y.indice;
+}
+
+ResultadoBusqueda buscarEnBaseDatos(const std::string& consulta,
+                                    const std::vector<SecuenciaDNA>& base,
+                                    const ConfiguracionAlineamiento& config,
+                                    std::size_t k, int threads) {
+    ResultadoBusqueda busqueda;
+    k = std::min(k, base.size());
+    if (k == 0) {
+        return busqueda;
+    }
+
+    auto t_inicio = std::chrono::high_resolution_clock::now();
+    if (threads <= 0) {
+        threads = omp_get_max_threads();
+    }
+    bool afin = config.puntuacion.gapAfin();
+
+    // Perfil de la consulta, compartido por todos los threads
+    std::string codigos_consulta;
+    std::vector<int> perfil;
+    codificarIUPAC(consulta, codigos_consulta);
+    if (afin || detectarEsquemaFijo(config.puntuacion) == ESQUEMA_GENERICO) {
+        construirPerfilConsulta(codigos_consulta, TablaSustitucionDNA(config.puntuacion), perfil);
+    }
+    for (const SecuenciaDNA& diana : base) {
+        busqueda.celdas += diana.longitud() * consulta.size();
+    }
+    long long num_dianas = static_cast<long long>(base.size());
+
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    #pragma omp parallel num_threads(threads)
+    {
+        EspacioTrabajo espacio;
+        // Montículo de mínimos: en la cima la peor de las K mejores del thread
+        std::priority_queue<AciertoBusqueda, std::vector<AciertoBusqueda>,
+                            bool (*)(const AciertoBusqueda&, const AciertoBusqueda&)> mejores(mejorAcierto);
+        #pragma omp for schedule(dynamic, TRAMO_BUSQUEDA)
+        for (long long d = 0; d < num_dianas; ++d) {
+            codificarIUPAC(base[d], espacio.codA);
+            int puntuacion = afin
+                ? puntuacionNWAfinCodificada(espacio.codA, codigos_consulta, perfil, config, espacio)
+                : puntuacionNWCodificada(espacio.codA, codigos_consulta, perfil, config, espacio);
+            AciertoBusqueda acierto = {static_cast<std::size_t>(d), puntuacion};
+            if (mejores.size() < k) {
+                mejores.push(acierto);
+            } else if (mejorAcierto(acierto, mejores.top())) {
+                mejores.pop();
+                mejores.push(acierto);
+            }
+        }
+        #pragma omp critical
+        {
+            while (!mejores.empty()) {
+                busqueda.mejores.push_back(mejores.top());
+                mejores.pop();
+            }
+        }
+        #pragma omp single
+        busqueda.threads = omp_get_num_threads();
+    }
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    std::sort(busqueda.mejores.begin(), busqueda.mejores.end(), mejorAcierto);
+    busqueda.mejores.resize(k);
+    auto t_fin_busqueda = std::chrono::high_resolution_clock::now();
+    busqueda.tiempo_busqueda_ms = std::chrono::duration<double, std::milli>(t_fin_busqueda - t_inicio).count();
+
+    // Traceback solo de las ganadoras
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    busqueda.alineamientos.resize(k);
+    long long num_mejores = static_cast<long long>(k);
+    #pragma omp parallel num_threads(threads)
+    {
+        EspacioTrabajo espacio;
+        #pragma omp for schedule(dynamic, 1)
+        for (long long r = 0; r < num_mejores; ++r) {
+            std::string diana = base[busqueda.mejores[r].indice].desempaquetar();
+            busqueda.alineamientos[r] = afin ? alineamientoNWAfin(consulta, diana, config, espacio)
+                                             : AlgNW(consulta, diana, config, espacio);
+        }
+    }
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    auto t_fin = std::chrono::high_resolution_clock::now();
+    busqueda.tiempo_traceback_ms = std::chrono::duration<double, std::milli>(t_fin - t_fin_busqueda).count();
+    return busqueda;
+}
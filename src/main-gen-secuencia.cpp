@@ -5,9 +5,11 @@
  * Uso:
  *   ./main-gen-secuencia -l <longitud> -s <similitud> -o <salida>
  *   ./main-gen-secuencia -b -o <directorio>  # Generar lote
+ *   ./main-gen-secuencia -c <entrada.fasta> -o <salida.nwb>  # Convertir a binario
  */
 
 #include "generador_secuencias.h"
+#include "secuencias_binarias.h"
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -19,16 +21,22 @@ void mostrarUso() {
     std::cout << "===========================\n\n";
     std::cout << "Uso:\n";
     std::cout << "  main-gen-secuencia -l <longitud> -s <similitud> -o <salida>\n";
-    std::cout << "  main-gen-secuencia -b -o <directorio>  # Generar lote\n\n";
+    std::cout << "  main-gen-secuencia -b -o <directorio>  # Generar lote\n";
+    std::cout << "  main-gen-secuencia -c <entrada.fasta> -o <salida.nwb>  # Convertir a binario\n\n";
     std::cout << "Opciones:\n";
     std::cout << "  -l, --longitud   Longitud de las secuencias DNA\n";
     std::cout << "  -s, --similitud  Similitud objetivo (0.0 - 1.0)\n";
     std::cout << "  -o, --salida     Prefijo del archivo de salida o directorio\n";
     std::cout << "  -b, --batch      Generar lote de secuencias\n";
+    std::cout << "  -B, --binario    Guardar en el formato binario indexado (.nwb) en vez de FASTA\n";
+    std::cout << "  -c, --convertir  Convertir un FASTA existente a .nwb (salida por defecto:\n";
+    std::cout << "                   el mismo nombre con extension .nwb)\n";
     std::cout << "  -h, --ayuda      Mostrar esta ayuda\n\n";
     std::cout << "Ejemplos:\n";
     std::cout << "  main-gen-secuencia -l 100 -s 0.9 -o datos/test\n";
-    std::cout << "  main-gen-secuencia -b -o datos/\n\n";
+    std::cout << "  main-gen-secuencia -b -o datos/\n";
+    std::cout << "  main-gen-secuencia -b -B -o datos/\n";
+    std::cout << "  main-gen-secuencia -c datos/grande.fasta\n\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -37,6 +45,9 @@ int main(int argc, char* argv[]) {
     double similitud = 0.9;
     std::string salida = "secuencias";
     bool modo_lote = false;
+    bool salida_indicada = false;
+    FormatoSecuencias formato = FORMATO_FASTA;
+    std::string convertir;
 
     // Parsear argumentos
     for (int i = 1; i < argc; ++i) {
@@ -62,10 +73,35 @@ int main(int argc, char* argv[]) {
         }
         else if ((arg == "-o" || arg == "--salida") && i + 1 < argc) {
             salida = argv[++i];
+            salida_indicada = true;
         }
         else if (arg == "-b" || arg == "--batch") {
             modo_lote = true;
         }
+        else if (arg == "-B" || arg == "--binario") {
+            formato = FORMATO_BINARIO;
+        }
+        else if ((arg == "-c" || arg == "--convertir") && i + 1 < argc) {
+            convertir = argv[++i];
+        }
+    }
+
+    if (!convertir.empty()) {
+        // Convertir un FASTA existente al contenedor binario
+        std::string nombreBinario = salida;
+        if (!salida_indicada) {
+            size_t punto = convertir.find_last_of('.');
+            size_t barra = convertir.find_last_of("/\\");
+            bool con_extension = punto != std::string::npos && (barra == std::string::npos || punto > barra);
+            nombreBinario = (con_extension ? convertir.substr(0, punto) : convertir) + ".nwb";
+        }
+        long long registros = convertirFastaABinario(convertir, nombreBinario);
+        if (registros < 0) {
+            std::cerr << "✗ Error al convertir " << convertir << "\n";
+            return 1;
+        }
+        std::cout << "✓ " << registros << " secuencias convertidas a: " << nombreBinario << "\n";
+        return 0;
     }
 
     if (modo_lote) {
@@ -76,7 +112,7 @@ int main(int argc, char* argv[]) {
         std::cout << "Generando lote de secuencias DNA...\n";
         std::cout << "Directorio: " << salida << "\n\n";
         
-        int generados = generarLoteSecuenciasDNA(salida, longitudes, similitudes);
+        int generados = generarLoteSecuenciasDNA(salida, longitudes, similitudes, formato);
         
         std::cout << "\n✓ Generados " << generados << " archivos\n";
     } else {
@@ -87,8 +123,8 @@ int main(int argc, char* argv[]) {
         
         ParSecuenciasDNA par = generarParSecuenciasDNA(longitud, similitud);
         
-        std::string nombreArchivo = salida + ".fasta";
-        if (guardarParSecuenciasDNAFASTA(par, nombreArchivo)) {
+        std::string nombreArchivo = salida + (formato == FORMATO_BINARIO ? ".nwb" : ".fasta");
+        if (guardarParSecuenciasDNAFASTA(par, nombreArchivo, "sec1", "sec2", formato)) {
             std::cout << "✓ Secuencias guardadas en: " << nombreArchivo << "\n";
             std::cout << "  Similitud real: " << std::fixed << std::setprecision(4) 
                       << par.similitud_real << "\n";
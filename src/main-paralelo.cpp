@@ -3,7 +3,7 @@
  * @brief Programa de benchmarking para comparar implementaciones secuencial y paralelas (DNA)
  * 
  * Uso:
- *   ./main-paralelo -f archivo.fasta -p <match> <mismatch> <gap> [-s] [-a] [-b] [-o salida.csv]
+ *   ./main-paralelo -f archivo.fasta -p <match> <mismatch> <gap> [-s] [-S] [-V] [-a] [-v] [-w] [-b] [-t] [-c] [-H] [-M] [-B] [-I] [-g <apertura>] [-X <x> | -Z <z>] [-L <largo|cubetas>] [-A <matriz.csv|matriz.bin> [-d]] [-Q <consulta.fasta> [-K <k>]] [-P <capacidad>] [-R <n>] [-D] [-C] [-o salida.csv]
  * 
  * Ejemplo:
  *   ./main-paralelo -f data/test.fasta -p 2 -1 -2 -a -b -o resultados.csv
@@ -22,12 +22,21 @@
 #include <random>
 #include <thread>
 #include <functional>
+#include <cstdint>
 
 // Incluir headers del proyecto
 #include "tipos.h"
 #include "puntuacion.h"
 #include "secuencial.h"
 #include "paralelo.h"
+#include "bitparalelo.h"
+#include "banda.h"
+#include "lote.h"
+#include "tuberia.h"
+#include "hirschberg.h"
+#include "afin.h"
+#include "simd_estriado.h"
+#include "traceback.h"
 #include "utilidades.h"
 #include <omp.h>
 
@@ -59,22 +68,16 @@ void limpiarCache() {
 }
 
 /**
- * @brief Guarda resultados en CSV
+ * @brief Abre el CSV de resultados para añadir filas, con la cabecera si está vacío
+ *
+ * @return false (con mensaje) si no se pudo abrir.
  */
-void guardarResultadosCSV(const std::string& archivo_salida,
-                         const std::string& archivo_fasta,
-                         const std::string& metodo,
-                         const ResultadoAlineamiento& resultado,
-                         int match, int mismatch, int gap,
-                         int repeticion = 0,
-                         int num_threads = 1,
-                         const std::string& schedule = "N/A") {
-    
-    std::ofstream csv(archivo_salida, std::ios::app);
+bool abrirResultadosCSV(std::ofstream& csv, const std::string& archivo_salida) {
+    csv.open(archivo_salida, std::ios::app);
     
     if (!csv.is_open()) {
         std::cerr << "Error: No se pudo abrir el archivo " << archivo_salida << "\n";
-        return;
+        return false;
     }
     
     csv.seekp(0, std::ios::end);
@@ -82,8 +85,29 @@ void guardarResultadosCSV(const std::string& archivo_salida,
     
     if (archivo_vacio) {
         csv << "archivo_fasta,metodo,repeticion,threads,schedule,longitud_A,longitud_B,match,mismatch,gap";
-        csv << ",tiempo_init_ms,tiempo_llenado_ms,tiempo_traceback_ms,tiempo_total_ms,puntuacion\n";
+        csv << ",tiempo_init_ms,tiempo_llenado_ms,tiempo_traceback_ms,tiempo_total_ms,puntuacion,lugares\n";
     }
+    return true;
+}
+
+/**
+ * @brief Escribe una fila de resultados en un CSV ya abierto
+ *
+ * Para resultados solo de puntuación (sin alineamiento) se registran las
+ * longitudes de entrada longitud_entrada_A/B. lugares es la colocación de
+ * threads (describirLugaresOpenMP); vacía se escribe "N/A".
+ */
+void escribirFilaCSV(std::ostream& csv,
+                     const std::string& archivo_fasta,
+                     const std::string& metodo,
+                     const ResultadoAlineamiento& resultado,
+                     int match, int mismatch, int gap,
+                     int repeticion,
+                     int num_threads,
+                     const std::string& schedule,
+                     const std::string& lugares,
+                     size_t longitud_entrada_A = 0,
+                     size_t longitud_entrada_B = 0) {
     
     double tiempo_total = resultado.tiempo_fase1_ms + resultado.tiempo_fase2_ms + resultado.tiempo_fase3_ms;
     
@@ -109,14 +133,44 @@ void guardarResultadosCSV(const std::string& archivo_salida,
     csv << repeticion << ",";
     csv << num_threads << ",";
     csv << escaparCSV(schedule) << ",";
-    csv << resultado.secA.length() << "," << resultado.secB.length() << ",";
+    if (resultado.solo_puntuacion) {
+        csv << longitud_entrada_A << "," << longitud_entrada_B << ",";
+    } else if (!resultado.cigar.empty()) {
+        csv << longitudCIGAR(resultado.cigar) << "," << longitudCIGAR(resultado.cigar) << ",";
+    } else {
+        csv << resultado.secA.length() << "," << resultado.secB.length() << ",";
+    }
     csv << match << "," << mismatch << "," << gap << ",";
     csv << std::fixed << std::setprecision(4);
     csv << resultado.tiempo_fase1_ms << "," << resultado.tiempo_fase2_ms << "," << resultado.tiempo_fase3_ms << ",";
     csv << tiempo_total << ",";
-    csv << resultado.puntuacion << "\n";
-    
-    csv.close();
+    csv << resultado.puntuacion << ",";
+    // Colocación de threads (OMP_PLACES/OMP_PROC_BIND), aparte del schedule
+    csv << (lugares.empty() ? "N/A" : lugares) << "\n";
+}
+
+/**
+ * @brief Guarda resultados en CSV
+ *
+ * Abre el archivo para una sola fila; para muchas filas seguidas,
+ * abrirResultadosCSV una vez y escribirFilaCSV por fila.
+ */
+void guardarResultadosCSV(const std::string& archivo_salida,
+                         const std::string& archivo_fasta,
+                         const std::string& metodo,
+                         const ResultadoAlineamiento& resultado,
+                         int match, int mismatch, int gap,
+                         int repeticion = 0,
+                         int num_threads = 1,
+                         const std::string& schedule = "N/A",
+                         size_t longitud_entrada_A = 0,
+                         size_t longitud_entrada_B = 0) {
+    std::ofstream csv;
+    if (!abrirResultadosCSV(csv, archivo_salida)) {
+        return;
+    }
+    escribirFilaCSV(csv, archivo_fasta, metodo, resultado, match, mismatch, gap, repeticion, num_threads,
+                    schedule, describirLugaresOpenMP(), longitud_entrada_A, longitud_entrada_B);
 }
 
 /**
@@ -135,6 +189,342 @@ ResultadoAlineamiento ejecutarConLimpiezaCache(
     return funcion(secA, secB, config);
 }
 
+/**
+ * @brief Modo lote (-L): alinea los pares consecutivos del FASTA, un par por thread
+ *
+ * Escribe una fila de CSV por par (repeticion = índice del par, schedule =
+ * planificación del lote) y un resumen de rendimiento por método.
+ */
+int ejecutarLote(const std::vector<SecuenciaDNA>& secuencias,
+                 const std::string& archivo_fasta,
+                 const std::string& archivo_salida,
+                 const ConfiguracionAlineamiento& config,
+                 PlanificacionLote planificacion,
+                 bool con_alineamiento, bool con_puntuacion,
+                 int xdrop, bool zdrop,
+                 int match, int mismatch, int gap) {
+    std::vector<std::string> textos(secuencias.size());
+    for (size_t k = 0; k < secuencias.size(); ++k) {
+        textos[k] = secuencias[k].desempaquetar();
+    }
+    std::vector<ParLote> pares = paresConsecutivos(textos.size());
+    std::cout << "=== MODO LOTE ===\n";
+    std::cout << "Secuencias: " << textos.size() << ", pares: " << pares.size()
+              << ", planificacion: " << nombrePlanificacionLote(planificacion) << "\n\n";
+    
+    for (int modo = 0; modo < 2; ++modo) {
+        bool solo_puntuacion = (modo == 1);
+        if (solo_puntuacion ? !con_puntuacion : !con_alineamiento) {
+            continue;
+        }
+        ConfiguracionAlineamiento config_lote = config;
+        std::string nombre = solo_puntuacion ? "lote_puntuacion" : "lote";
+        if (config.puntuacion.gapAfin()) {
+            nombre += "_afin";
+        } else if (!solo_puntuacion && xdrop > 0) {
+            config_lote.xdrop = xdrop;
+            config_lote.zdrop = zdrop;
+            nombre += zdrop ? "_zdrop" : "_xdrop";
+        }
+        if (!solo_puntuacion && config.salida_cigar) {
+            nombre += "_cigar";
+        }
+        if (config.puntuacion.iupac) {
+            nombre += "_iupac";
+        }
+        
+        OpcionesLote opciones;
+        opciones.solo_puntuacion = solo_puntuacion;
+        opciones.planificacion = planificacion;
+        std::cout << "--- Metodo: " << nombre << " ---\n";
+        std::cout << "  Ejecutando... ";
+        std::cout.flush();
+        limpiarCache();
+        ResultadoLote lote = alinearLote(textos, pares, config_lote, opciones);
+        
+        double suma_ms = 0.0;
+        for (size_t p = 0; p < lote.resultados.size(); ++p) {
+            const ResultadoAlineamiento& resultado = lote.resultados[p];
+            suma_ms += resultado.tiempo_fase1_ms + resultado.tiempo_fase2_ms + resultado.tiempo_fase3_ms;
+            guardarResultadosCSV(archivo_salida, archivo_fasta, nombre, resultado, match, mismatch, gap,
+                                 static_cast<int>(p), lote.threads, nombrePlanificacionLote(planificacion),
+                                 textos[pares[p].a].length(), textos[pares[p].b].length());
+        }
+        double gcups = (lote.tiempo_total_ms > 0.0) ? lote.celdas / (lote.tiempo_total_ms * 1e6) : 0.0;
+        std::cout << "Tiempo: " << std::fixed << std::setprecision(2) << lote.tiempo_total_ms << " ms ("
+                  << lote.threads << " threads)\n";
+        std::cout << "  Celdas: " << lote.celdas << ", GCUPS: " << std::setprecision(3) << gcups
+                  << ", suma de tiempos por par: " << std::setprecision(2) << suma_ms << " ms";
+        if (lote.tiempo_total_ms > 0.0) {
+            std::cout << " (x" << suma_ms / lote.tiempo_total_ms << ")";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n=== LOTE COMPLETADO ===\n";
+    std::cout << "Resultados guardados en: " << archivo_salida << "\n";
+    return 0;
+}
+
+/**
+ * @brief Valor (i, j) de la matriz de salida: puntuación o distancia.
+ */
+static double valorMatriz(const MatrizPuntuaciones& matriz, std::size_t i, std::size_t j, bool distancias) {
+    return distancias ? matriz.distancia(i, j) : matriz(i, j);
+}
+
+/**
+ * @brief Guarda la matriz N x N completa en CSV (una fila por secuencia, sin cabecera).
+ */
+bool guardarMatrizCSV(const std::string& archivo, const MatrizPuntuaciones& matriz, bool distancias) {
+    std::ofstream salida(archivo);
+    if (!salida.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << archivo << " para escritura\n";
+        return false;
+    }
+    if (distancias) {
+        salida << std::fixed << std::setprecision(1);
+    }
+    for (std::size_t i = 0; i < matriz.tamano(); ++i) {
+        for (std::size_t j = 0; j < matriz.tamano(); ++j) {
+            if (j > 0) salida << ",";
+            salida << valorMatriz(matriz, i, j, distancias);
+        }
+        salida << "\n";
+    }
+    return true;
+}
+
+/**
+ * @brief Guarda la matriz N x N completa en binario.
+ *
+ * Formato (orden de bytes de la máquina): "NWMP", uint32 N, uint32 tipo
+ * (0 = int32 puntuaciones, 1 = float64 distancias) y N·N valores por filas.
+ */
+bool guardarMatrizBinaria(const std::string& archivo, const MatrizPuntuaciones& matriz, bool distancias) {
+    std::ofstream salida(archivo, std::ios::binary);
+    if (!salida.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << archivo << " para escritura\n";
+        return false;
+    }
+    uint32_t cabecera[2] = {static_cast<uint32_t>(matriz.tamano()), distancias ? 1u : 0u};
+    salida.write("NWMP", 4);
+    salida.write(reinterpret_cast<const char*>(cabecera), sizeof(cabecera));
+    std::vector<int32_t> fila_enteros(matriz.tamano());
+    std::vector<double> fila_reales(matriz.tamano());
+    for (std::size_t i = 0; i < matriz.tamano(); ++i) {
+        for (std::size_t j = 0; j < matriz.tamano(); ++j) {
+            if (distancias) {
+                fila_reales[j] = matriz.distancia(i, j);
+            } else {
+                fila_enteros[j] = matriz(i, j);
+            }
+        }
+        if (distancias) {
+            salida.write(reinterpret_cast<const char*>(fila_reales.data()), fila_reales.size() * sizeof(double));
+        } else {
+            salida.write(reinterpret_cast<const char*>(fila_enteros.data()), fila_enteros.size() * sizeof(int32_t));
+        }
+    }
+    return static_cast<bool>(salida);
+}
+
+/**
+ * @brief Modo todos contra todos (-A): matriz de puntuaciones de todos los pares del FASTA
+ *
+ * Se guarda en CSV o, si el nombre termina en ".bin", en binario.
+ */
+int ejecutarTodosContraTodos(const std::vector<SecuenciaDNA>& secuencias,
+                             const std::string& archivo_matriz,
+                             const ConfiguracionAlineamiento& config,
+                             bool distancias) {
+    std::vector<std::string> textos(secuencias.size());
+    for (size_t k = 0; k < secuencias.size(); ++k) {
+        textos[k] = secuencias[k].desempaquetar();
+    }
+    std::cout << "=== MODO TODOS CONTRA TODOS ===\n";
+    std::cout << "Secuencias: " << textos.size() << "\n";
+    std::cout << "  Ejecutando... ";
+    std::cout.flush();
+    limpiarCache();
+    ResultadoTodosContraTodos todos = puntuacionesTodosContraTodos(textos, config);
+    
+    double gcups = (todos.tiempo_total_ms > 0.0) ? todos.celdas / (todos.tiempo_total_ms * 1e6) : 0.0;
+    std::cout << "Tiempo: " << std::fixed << std::setprecision(2) << todos.tiempo_total_ms << " ms ("
+              << todos.threads << " threads)\n";
+    std::cout << "  Pares (i <= j): " << todos.pares << ", bloque: " << todos.tam_bloque
+              << " secuencias, celdas: " << todos.celdas << ", GCUPS: " << std::setprecision(3) << gcups << "\n";
+    
+    bool binario = archivo_matriz.size() >= 4 &&
+                   archivo_matriz.compare(archivo_matriz.size() - 4, 4, ".bin") == 0;
+    bool guardado = binario ? guardarMatrizBinaria(archivo_matriz, todos.puntuaciones, distancias)
+                            : guardarMatrizCSV(archivo_matriz, todos.puntuaciones, distancias);
+    if (!guardado) {
+        return 1;
+    }
+    std::cout << "\n=== TODOS CONTRA TODOS COMPLETADO ===\n";
+    std::cout << "Matriz de " << (distancias ? "distancias" : "puntuaciones") << " ("
+              << (binario ? "binaria" : "CSV") << ") guardada en: " << archivo_matriz << "\n";
+    return 0;
+}
+
+/**
+ * @brief Modo búsqueda (-Q): la consulta frente a todas las secuencias del FASTA, K mejores
+ *
+ * Escribe una fila de CSV por diana ganadora, de mejor a peor (repeticion =
+ * índice de la diana en el FASTA, schedule = "top<K>").
+ */
+int ejecutarBusqueda(const std::vector<SecuenciaDNA>& secuencias,
+                     const std::string& consulta,
+                     const std::string& archivo_fasta,
+                     const std::string& archivo_salida,
+                     const ConfiguracionAlineamiento& config,
+                     std::size_t k,
+                     int match, int mismatch, int gap) {
+    std::string nombre = "busqueda";
+    if (config.puntuacion.gapAfin()) {
+        nombre += "_afin";
+    } else if (config.xdrop > 0) {
+        nombre += config.zdrop ? "_zdrop" : "_xdrop";
+    }
+    if (config.salida_cigar) {
+        nombre += "_cigar";
+    }
+    if (config.puntuacion.iupac) {
+        nombre += "_iupac";
+    }
+    std::cout << "=== MODO BUSQUEDA ===\n";
+    std::cout << "Consulta: " << consulta.length() << " caracteres, dianas: " << secuencias.size()
+              << ", K = " << k << "\n";
+    std::cout << "--- Metodo: " << nombre << " ---\n";
+    std::cout << "  Ejecutando... ";
+    std::cout.flush();
+    limpiarCache();
+    ResultadoBusqueda busqueda = buscarEnBaseDatos(consulta, secuencias, config, k);
+    
+    double gcups = (busqueda.tiempo_busqueda_ms > 0.0) ? busqueda.celdas / (busqueda.tiempo_busqueda_ms * 1e6) : 0.0;
+    std::cout << "Puntuacion de la base: " << std::fixed << std::setprecision(2) << busqueda.tiempo_busqueda_ms
+              << " ms (" << busqueda.threads << " threads, GCUPS: " << std::setprecision(3) << gcups << ")\n";
+    std::cout << "  Traceback de las " << busqueda.mejores.size() << " mejores: " << std::setprecision(2)
+              << busqueda.tiempo_traceback_ms << " ms\n\n";
+    std::cout << "  Puesto  Diana  Longitud  Puntuacion\n";
+    std::string schedule = "top" + std::to_string(k);
+    for (size_t r = 0; r < busqueda.mejores.size(); ++r) {
+        const AciertoBusqueda& acierto = busqueda.mejores[r];
+        std::cout << "  " << std::setw(6) << r + 1 << "  " << std::setw(5) << acierto.indice << "  "
+                  << std::setw(8) << secuencias[acierto.indice].longitud() << "  " << std::setw(10)
+                  << acierto.puntuacion << "\n";
+        guardarResultadosCSV(archivo_salida, archivo_fasta, nombre, busqueda.alineamientos[r], match, mismatch, gap,
+                             static_cast<int>(acierto.indice), busqueda.threads, schedule);
+    }
+    std::cout << "\n=== BUSQUEDA COMPLETADA ===\n";
+    std::cout << "Resultados guardados en: " << archivo_salida << "\n";
+    return 0;
+}
+
+/**
+ * @brief Imprime una línea del resumen por etapas de la tubería
+ */
+static void imprimirEtapa(const char* nombre, const EstadisticasEtapa& etapa, const char* unidad,
+                          double escala, double tiempo_total_ms) {
+    double por_thread_ms = (etapa.threads > 0) ? etapa.ocupado_ms / etapa.threads : 0.0;
+    std::cout << "  " << std::left << std::setw(12) << nombre << std::right
+              << std::setw(3) << etapa.threads << " threads  " << std::setw(8) << etapa.elementos << " pares  "
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << ((por_thread_ms > 0.0) ? etapa.elementos / por_thread_ms * 1000.0 : 0.0) << " pares/s  "
+              << std::setprecision(3) << std::setw(9)
+              << ((etapa.ocupado_ms > 0.0) ? etapa.volumen / (etapa.ocupado_ms * 1000.0) / escala * etapa.threads : 0.0)
+              << " " << unidad << "  ocupado " << std::setprecision(1) << std::setw(5)
+              << 100.0 * etapa.utilizacion(tiempo_total_ms) << "%  espera " << std::setprecision(2)
+              << etapa.espera_ms << " ms\n";
+}
+
+/**
+ * @brief Modo tubería (-P): lectura, alineamiento y escritura solapados sobre los pares consecutivos
+ *
+ * El FASTA no se carga entero: la memoria depende de la capacidad de las
+ * colas. Escribe una fila de CSV por par, en orden de llegada (repeticion =
+ * índice del par, schedule = "cola<capacidad>"), y un resumen por etapas.
+ */
+int ejecutarTuberia(const std::string& archivo_fasta,
+                    const std::string& archivo_salida,
+                    const ConfiguracionAlineamiento& config,
+                    std::size_t capacidad,
+                    bool con_alineamiento, bool con_puntuacion,
+                    int xdrop, bool zdrop,
+                    int match, int mismatch, int gap) {
+    std::cout << "=== MODO TUBERIA ===\n";
+    std::cout << "Capacidad de las colas: " << capacidad << " pares\n\n";
+    std::string schedule = "cola" + std::to_string(capacidad);
+    // Un solo flujo abierto para todas las filas (el escritor escribe una por par)
+    std::ofstream csv;
+    if (!abrirResultadosCSV(csv, archivo_salida)) {
+        return 1;
+    }
+    std::string lugares = describirLugaresOpenMP();
+    
+    for (int modo = 0; modo < 2; ++modo) {
+        bool solo_puntuacion = (modo == 1);
+        if (solo_puntuacion ? !con_puntuacion : !con_alineamiento) {
+            continue;
+        }
+        ConfiguracionAlineamiento config_tuberia = config;
+        std::string nombre = solo_puntuacion ? "tuberia_puntuacion" : "tuberia";
+        if (config.puntuacion.gapAfin()) {
+            nombre += "_afin";
+        } else if (!solo_puntuacion && xdrop > 0) {
+            config_tuberia.xdrop = xdrop;
+            config_tuberia.zdrop = zdrop;
+            nombre += zdrop ? "_zdrop" : "_xdrop";
+        }
+        if (!solo_puntuacion && config.salida_cigar) {
+            nombre += "_cigar";
+        }
+        if (config.puntuacion.iupac) {
+            nombre += "_iupac";
+        }
+        
+        OpcionesTuberia opciones;
+        opciones.capacidad_cola = capacidad;
+        opciones.solo_puntuacion = solo_puntuacion;
+        std::cout << "--- Metodo: " << nombre << " ---\n";
+        std::cout << "  Ejecutando... ";
+        std::cout.flush();
+        ResultadoTuberia tuberia = alinearEnTuberia(
+            archivo_fasta, config_tuberia, opciones,
+            [&](const ParAlineado& alineado) {
+                escribirFilaCSV(csv, archivo_fasta, nombre, alineado.resultado, match, mismatch, gap,
+                                static_cast<int>(alineado.indice), alineado.trabajadores, schedule, lugares,
+                                alineado.longitud_a, alineado.longitud_b);
+            });
+        if (!tuberia.correcto) {
+            return 1;
+        }
+        
+        double gcups = (tuberia.tiempo_total_ms > 0.0)
+            ? tuberia.alineamiento.volumen / (tuberia.tiempo_total_ms * 1e6) : 0.0;
+        std::cout << "Tiempo: " << std::fixed << std::setprecision(2) << tuberia.tiempo_total_ms << " ms, "
+                  << tuberia.escritura.elementos << " pares, GCUPS: " << std::setprecision(3) << gcups << "\n";
+        std::cout << "  Etapas (capacidad = ritmo si la etapa trabajara todo el tiempo; ocupado = fraccion del total):\n";
+        imprimirEtapa("lectura", tuberia.lectura, "Mbases/s", 1.0, tuberia.tiempo_total_ms);
+        imprimirEtapa("alineamiento", tuberia.alineamiento, "GCUPS", 1000.0, tuberia.tiempo_total_ms);
+        imprimirEtapa("escritura", tuberia.escritura, "Mfilas/s", 1.0, tuberia.tiempo_total_ms);
+        
+        const char* cuello = "lectura";
+        double maxima = tuberia.lectura.utilizacion(tuberia.tiempo_total_ms);
+        if (tuberia.alineamiento.utilizacion(tuberia.tiempo_total_ms) > maxima) {
+            cuello = "alineamiento";
+            maxima = tuberia.alineamiento.utilizacion(tuberia.tiempo_total_ms);
+        }
+        if (tuberia.escritura.utilizacion(tuberia.tiempo_total_ms) > maxima) {
+            cuello = "escritura";
+        }
+        std::cout << "  Etapa limitante: " << cuello << "\n";
+    }
+    std::cout << "\n=== TUBERIA COMPLETADA ===\n";
+    std::cout << "Resultados guardados en: " << archivo_salida << "\n";
+    return 0;
+}
+
 /**
  * @brief Muestra el uso del programa
  */
@@ -144,18 +534,52 @@ void mostrarUso(const char* nombre_programa) {
     std::cout << "  -f <archivo.fasta>    Archivo FASTA con las secuencias DNA (OBLIGATORIO)\n";
     std::cout << "  -p <match> <mismatch> <gap>   Parametros de puntuacion (OBLIGATORIO)\n";
     std::cout << "  -s                    Ejecutar método secuencial\n";
+    std::cout << "  -S                    Ejecutar solo puntuación secuencial (dos filas, sin traceback)\n";
+    std::cout << "  -V                    Ejecutar solo puntuación con kernel SIMD estriado (SSE4.1/AVX2)\n";
     std::cout << "  -a                    Ejecutar método antidiagonal (schedule desde OMP_SCHEDULE)\n";
+    std::cout << "  -v                    Ejecutar método antidiagonal sesgado + SIMD (schedule desde OMP_SCHEDULE)\n";
+    std::cout << "  -w                    Ejecutar método antidiagonal con una sola región paralela (reparto estático)\n";
     std::cout << "  -b                    Ejecutar método bloques (schedule desde OMP_SCHEDULE)\n";
+    std::cout << "  -t                    Ejecutar método bloques con tareas OpenMP (dependencias entre teselas)\n";
+    std::cout << "  -c                    Ejecutar método franjas de columnas en pipeline (sincronización punto a punto)\n";
+    std::cout << "  -H                    Ejecutar método Hirschberg (espacio lineal, tareas OpenMP)\n";
+    std::cout << "  -M                    Ejecutar método bit-paralelo (Myers) + traceback en banda (esquemas tipo distancia de edición)\n";
+    std::cout << "  -B                    Ejecutar método de banda adaptativa (duplica el ancho hasta demostrar el óptimo)\n";
+    std::cout << "  -I                    Puntuación IUPAC en todos los métodos (R, Y, N, ... puntúan por bases compatibles)\n";
+    std::cout << "  -g <apertura>         Gap afín (Gotoh): un gap de k bases puntúa apertura + k*gap.\n";
+    std::cout << "                        Solo -s, -S, -b y -w tienen variante afín (afin, puntuacion_afin,\n";
+    std::cout << "                        afin_bloques, afin_antidiagonal); el resto de métodos se omite\n";
+    std::cout << "  -X <x>                Poda X-drop en -s y -a: descarta celdas mas de x por debajo de la mejor\n";
+    std::cout << "                        y corta el alineamiento si no queda ninguna viva\n";
+    std::cout << "  -Z <z>                Como -X, pero con Z-drop (el umbral se relaja con la distancia en diagonales)\n";
+    std::cout << "  -L <largo|cubetas>    Modo lote: alinea los pares consecutivos del FASTA (1-2, 3-4, ...) con un\n";
+    std::cout << "                        par por thread; -s = alineamiento, -S = solo puntuacion (por defecto).\n";
+    std::cout << "                        largo = mas largo primero, cubetas = cubetas por tamaño\n";
+    std::cout << "  -A <matriz>           Modo todos contra todos: puntuacion NW de todos los pares del FASTA\n";
+    std::cout << "                        (matriz simetrica N x N) en CSV, o binaria si el nombre acaba en .bin\n";
+    std::cout << "  -d                    Con -A, guarda distancias (S(i,i) + S(j,j)) / 2 - S(i,j)\n";
+    std::cout << "  -Q <consulta.fasta>   Modo busqueda: la primera secuencia de consulta.fasta frente a todas las\n";
+    std::cout << "                        de -f (solo puntuacion); alinea completas solo las K mejores\n";
+    std::cout << "  -K <k>                Con -Q, dianas a conservar [default: 10]\n";
+    std::cout << "  -P <capacidad>        Modo tuberia: lee, alinea y escribe en paralelo los pares consecutivos\n";
+    std::cout << "                        sin cargar el FASTA (colas de <capacidad> pares; 1 lector, 1 escritor y\n";
+    std::cout << "                        OMP_NUM_THREADS - 2 trabajadores); -s y -S como en -L\n";
+    std::cout << "  -D                    Traceback con matriz de direcciones de 2 bits en -s, -a y -b\n";
+    std::cout << "  -C                    Salida compacta CIGAR en lugar de las secuencias alineadas\n";
+    std::cout << "  -R <n>                Repite cada metodo n veces en el mismo proceso (columna repeticion\n";
+    std::cout << "                        = 1..n); los motores con espacio de trabajo reutilizan su memoria\n";
+    std::cout << "                        desde la repeticion 2 [default: 1]\n";
     std::cout << "  -o <archivo.csv>      Archivo de salida CSV [default: benchmark.csv]\n";
     std::cout << "  -h, --help           Mostrar esta ayuda\n\n";
     std::cout << "Ejemplos:\n";
     std::cout << "  " << nombre_programa << " -f data/test.fasta -p 2 -1 -2 -a -b\n";
     std::cout << "  " << nombre_programa << " -f data/test.fasta -p 2 -1 -2 -s -a -o resultados.csv\n";
     std::cout << "  " << nombre_programa << " -f data/test.fasta -p 2 -1 -2 -b -o resultados.csv\n\n";
-    std::cout << "NOTA: Debe especificar al menos un método (-s, -a, o -b)\n";
+    std::cout << "NOTA: Debe especificar al menos un método (-s, -S, -V, -a, -v, -w, -b, -t, -c, -H, -M o -B)\n";
     std::cout << "NOTA: Configure OMP_NUM_THREADS y OMP_SCHEDULE para controlar paralelización:\n";
     std::cout << "  export OMP_NUM_THREADS=8\n";
     std::cout << "  export OMP_SCHEDULE=\"dynamic,1\"\n";
+    std::cout << "  export OMP_PLACES=cores OMP_PROC_BIND=spread   # fija threads (NUMA); columna 'lugares' del CSV\n";
 }
 
 /**
@@ -166,9 +590,32 @@ int main(int argc, char* argv[]) {
     std::string archivo_fasta = "";
     std::string archivo_salida = "benchmark.csv";
     bool ejecutar_secuencial = false;
+    bool ejecutar_puntuacion = false;
+    bool ejecutar_puntuacion_simd = false;
     bool ejecutar_antidiagonal = false;
+    bool ejecutar_antidiagonal_simd = false;
+    bool ejecutar_antidiagonal_persistente = false;
     bool ejecutar_bloques = false;
+    bool ejecutar_tareas = false;
+    bool ejecutar_franjas = false;
+    bool ejecutar_hirschberg = false;
+    bool ejecutar_bitparalelo = false;
+    bool ejecutar_banda = false;
+    bool usar_iupac = false;
+    bool usar_direcciones = false;
+    bool usar_cigar = false;
     int match = 0, mismatch = 0, gap = 0;
+    int apertura = 0;
+    int xdrop = 0;
+    bool zdrop = false;
+    bool modo_lote = false;
+    PlanificacionLote planificacion_lote = LOTE_MAS_LARGO_PRIMERO;
+    std::string archivo_matriz = "";
+    bool guardar_distancias = false;
+    std::string archivo_consulta = "";
+    int mejores_busqueda = 10;
+    int capacidad_tuberia = 0;
+    int repeticiones = 1;
     bool parametros_validos = false;
     
     for (int i = 1; i < argc; ++i) {
@@ -183,12 +630,94 @@ int main(int argc, char* argv[]) {
         else if (arg == "-s") {
             ejecutar_secuencial = true;
         }
+        else if (arg == "-S") {
+            ejecutar_puntuacion = true;
+        }
+        else if (arg == "-V") {
+            ejecutar_puntuacion_simd = true;
+        }
         else if (arg == "-a") {
             ejecutar_antidiagonal = true;
         }
+        else if (arg == "-v") {
+            ejecutar_antidiagonal_simd = true;
+        }
+        else if (arg == "-w") {
+            ejecutar_antidiagonal_persistente = true;
+        }
         else if (arg == "-b") {
             ejecutar_bloques = true;
         }
+        else if (arg == "-t") {
+            ejecutar_tareas = true;
+        }
+        else if (arg == "-c") {
+            ejecutar_franjas = true;
+        }
+        else if (arg == "-H") {
+            ejecutar_hirschberg = true;
+        }
+        else if (arg == "-M") {
+            ejecutar_bitparalelo = true;
+        }
+        else if (arg == "-B") {
+            ejecutar_banda = true;
+        }
+        else if (arg == "-I") {
+            usar_iupac = true;
+        }
+        else if (arg == "-D") {
+            usar_direcciones = true;
+        }
+        else if (arg == "-C") {
+            usar_cigar = true;
+        }
+        else if (arg == "-g" && i + 1 < argc) {
+            apertura = std::atoi(argv[++i]);
+        }
+        else if (arg == "-L" && i + 1 < argc) {
+            std::string planificacion = argv[++i];
+            if (planificacion != "largo" && planificacion != "cubetas") {
+                std::cerr << "Error: planificacion de lote desconocida '" << planificacion
+                          << "' (use largo o cubetas)\n\n";
+                mostrarUso(argv[0]);
+                return 1;
+            }
+            modo_lote = true;
+            planificacion_lote = (planificacion == "cubetas") ? LOTE_CUBETAS : LOTE_MAS_LARGO_PRIMERO;
+        }
+        else if (arg == "-A" && i + 1 < argc) {
+            archivo_matriz = argv[++i];
+        }
+        else if (arg == "-d") {
+            guardar_distancias = true;
+        }
+        else if (arg == "-Q" && i + 1 < argc) {
+            archivo_consulta = argv[++i];
+        }
+        else if (arg == "-K" && i + 1 < argc) {
+            mejores_busqueda = std::atoi(argv[++i]);
+        }
+        else if (arg == "-P" && i + 1 < argc) {
+            capacidad_tuberia = std::atoi(argv[++i]);
+            if (capacidad_tuberia < 1) {
+                std::cerr << "Error: la capacidad de -P debe ser al menos 1\n\n";
+                mostrarUso(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "-R" && i + 1 < argc) {
+            repeticiones = std::atoi(argv[++i]);
+            if (repeticiones < 1) {
+                std::cerr << "Error: -R debe ser al menos 1\n\n";
+                mostrarUso(argv[0]);
+                return 1;
+            }
+        }
+        else if ((arg == "-X" || arg == "-Z") && i + 1 < argc) {
+            xdrop = std::atoi(argv[++i]);
+            zdrop = (arg == "-Z");
+        }
         else if (arg == "-p" && i + 3 < argc) {
             match = std::atoi(argv[++i]);
             mismatch = std::atoi(argv[++i]);
@@ -213,30 +742,80 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    std::vector<std::string> secuencias = leerArchivoFasta(archivo_fasta);
+    if (capacidad_tuberia > 0) {
+        // La tubería lee el FASTA en flujo: no se carga antes
+        if (modo_lote || !archivo_matriz.empty() || !archivo_consulta.empty()) {
+            std::cerr << "Aviso: -P tiene prioridad; se ignoran -L, -A y -Q\n";
+        }
+        ConfiguracionAlineamiento config(match, mismatch, gap, false);
+        config.traceback_direcciones = usar_direcciones;
+        config.salida_cigar = usar_cigar;
+        config.puntuacion.iupac = usar_iupac;
+        config.puntuacion.parametros.apertura = apertura;
+        return ejecutarTuberia(archivo_fasta, archivo_salida, config, static_cast<std::size_t>(capacidad_tuberia),
+                               ejecutar_secuencial, ejecutar_puntuacion || !ejecutar_secuencial,
+                               xdrop, zdrop, match, mismatch, gap);
+    }
+    
+    // Se empaquetan a 2 bits al leer; solo se desempaquetan las dos que se alinean
+    std::vector<SecuenciaDNA> secuencias = leerArchivoFastaDNA(archivo_fasta);
     
-    if (secuencias.size() < 2) {
-        std::cerr << "Error: El archivo FASTA debe contener al menos 2 secuencias\n";
+    // En modo búsqueda A es la consulta y B la primera diana
+    bool modo_busqueda = !archivo_consulta.empty();
+    std::vector<SecuenciaDNA> consultas;
+    if (modo_busqueda) {
+        consultas = leerArchivoFastaDNA(archivo_consulta);
+        if (consultas.empty()) {
+            std::cerr << "Error: El archivo de consulta no contiene ninguna secuencia\n";
+            return 1;
+        }
+        if (mejores_busqueda < 1) {
+            std::cerr << "Error: -K debe ser al menos 1\n";
+            return 1;
+        }
+    }
+    
+    if (secuencias.size() < (modo_busqueda ? 1u : 2u)) {
+        std::cerr << "Error: El archivo FASTA debe contener al menos " << (modo_busqueda ? 1 : 2) << " secuencias\n";
         return 1;
     }
     
-    std::string secA = secuencias[0];
-    std::string secB = secuencias[1];
+    std::string secA = modo_busqueda ? consultas[0].desempaquetar() : secuencias[0].desempaquetar();
+    std::string secB = secuencias[modo_busqueda ? 0 : 1].desempaquetar();
     
-    // Validar que se haya especificado al menos un método
-    if (!ejecutar_secuencial && !ejecutar_antidiagonal && !ejecutar_bloques) {
-        std::cerr << "Error: Debe especificar al menos un método (-s, -a, o -b)\n\n";
+    // Validar que se haya especificado al menos un método (los modos lote, -A y -Q usan -S por defecto)
+    if (!modo_lote && archivo_matriz.empty() && !modo_busqueda && !ejecutar_secuencial && !ejecutar_puntuacion && !ejecutar_puntuacion_simd &&
+        !ejecutar_antidiagonal && !ejecutar_antidiagonal_simd && !ejecutar_antidiagonal_persistente &&
+        !ejecutar_bloques && !ejecutar_tareas && !ejecutar_franjas && !ejecutar_hirschberg &&
+        !ejecutar_bitparalelo && !ejecutar_banda) {
+        std::cerr << "Error: Debe especificar al menos un método (-s, -S, -V, -a, -v, -w, -b, -t, -c, -H, -M o -B)\n\n";
         mostrarUso(argv[0]);
         return 1;
     }
     
     std::cout << "Secuencia A: " << secA.length() << " caracteres\n";
     std::cout << "Secuencia B: " << secB.length() << " caracteres\n";
-    std::cout << "Parametros: match=" << match << ", mismatch=" << mismatch << ", gap=" << gap << "\n";
+    std::cout << "Parametros: match=" << match << ", mismatch=" << mismatch << ", gap=" << gap;
+    if (apertura != 0) {
+        std::cout << ", apertura=" << apertura;
+    }
+    std::cout << "\n";
     std::cout << "Metodos seleccionados: ";
+    if (!archivo_matriz.empty()) std::cout << "todos_contra_todos ";
+    if (modo_busqueda) std::cout << "busqueda (K = " << mejores_busqueda << ") ";
+    if (modo_lote) std::cout << "lote (" << nombrePlanificacionLote(planificacion_lote) << ") ";
     if (ejecutar_secuencial) std::cout << "secuencial ";
+    if (ejecutar_puntuacion) std::cout << "puntuacion ";
+    if (ejecutar_puntuacion_simd) std::cout << "puntuacion_simd ";
     if (ejecutar_antidiagonal) std::cout << "antidiagonal ";
+    if (ejecutar_antidiagonal_simd) std::cout << "antidiagonal_simd ";
+    if (ejecutar_antidiagonal_persistente) std::cout << "antidiagonal_persistente ";
     if (ejecutar_bloques) std::cout << "bloques ";
+    if (ejecutar_tareas) std::cout << "tareas ";
+    if (ejecutar_franjas) std::cout << "franjas ";
+    if (ejecutar_hirschberg) std::cout << "hirschberg ";
+    if (ejecutar_bitparalelo) std::cout << "bitparalelo ";
+    if (ejecutar_banda) std::cout << "banda_adaptativa ";
     std::cout << "\n";
     
     std::cout << "\n=== CONFIGURACIÓN OPENMP ===\n";
@@ -252,25 +831,172 @@ int main(int argc, char* argv[]) {
     } else {
         std::cout << "OMP_SCHEDULE: default (static)\n";
     }
+    const char* places_env = std::getenv("OMP_PLACES");
+    const char* proc_bind_env = std::getenv("OMP_PROC_BIND");
+    std::string lugares = describirLugaresOpenMP();
+    std::cout << "OMP_PLACES: " << (places_env != nullptr ? places_env : "no definido")
+              << ", OMP_PROC_BIND: " << (proc_bind_env != nullptr ? proc_bind_env : "no definido");
+    if (!lugares.empty()) std::cout << " (" << lugares << ")";
+    std::cout << "\n";
     std::cout << "Threads máximos disponibles: " << omp_get_max_threads() << "\n";
+    std::cout << "SIMD disponible: " << nombreConjuntoSimd(detectarConjuntoSimd()) << "\n";
     std::cout << "============================\n\n";
     
     ConfiguracionAlineamiento config(match, mismatch, gap, false);
+    config.traceback_direcciones = usar_direcciones;
+    config.salida_cigar = usar_cigar;
+    config.puntuacion.iupac = usar_iupac;
+    config.puntuacion.parametros.apertura = apertura;
+    // En el CSV los métodos con matriz de direcciones llevan sufijo "_dir" y
+    // los de salida compacta "_cigar" (sufijo_dir incluye ambos)
+    std::string sufijo_cigar = usar_cigar ? "_cigar" : "";
+    std::string sufijo_dir = (usar_direcciones ? "_dir" : "") + sufijo_cigar;
+    // La poda solo la aplican -s y -a; el resto de métodos recibe config sin ella
+    std::string sufijo_poda = std::string(zdrop ? "_zdrop" : "_xdrop") + sufijo_cigar;
+    
+    if (modo_busqueda) {
+        if (modo_lote || !archivo_matriz.empty()) {
+            std::cerr << "Aviso: -Q tiene prioridad; se ignoran -L y -A\n";
+        }
+        config.xdrop = config.puntuacion.gapAfin() ? 0 : xdrop;
+        config.zdrop = zdrop;
+        return ejecutarBusqueda(secuencias, secA, archivo_fasta, archivo_salida, config,
+                                static_cast<std::size_t>(mejores_busqueda), match, mismatch, gap);
+    }
+    
+    if (!archivo_matriz.empty()) {
+        if (modo_lote || xdrop > 0) {
+            std::cerr << "Aviso: -A calcula solo puntuaciones; se ignoran -L y -X/-Z\n";
+        }
+        return ejecutarTodosContraTodos(secuencias, archivo_matriz, config, guardar_distancias);
+    }
     
+    if (modo_lote) {
+        if (ejecutar_puntuacion_simd || ejecutar_antidiagonal || ejecutar_antidiagonal_simd ||
+            ejecutar_antidiagonal_persistente || ejecutar_bloques || ejecutar_tareas || ejecutar_franjas ||
+            ejecutar_hirschberg || ejecutar_bitparalelo || ejecutar_banda) {
+            std::cerr << "Aviso: en modo lote solo se ejecutan -s y -S (el paralelismo es entre pares)\n";
+        }
+        return ejecutarLote(secuencias, archivo_fasta, archivo_salida, config, planificacion_lote,
+                            ejecutar_secuencial, ejecutar_puntuacion || !ejecutar_secuencial,
+                            xdrop, zdrop, match, mismatch, gap);
+    }
+    
+    typedef ResultadoAlineamiento (*MotorConEspacio)(const std::string&, const std::string&,
+                                                     const ConfiguracionAlineamiento&, EspacioTrabajo&);
+    // Los motores con versión EspacioTrabajo se registran en con_espacio (funcion queda vacía)
     struct MetodoPrueba {
         std::string nombre;
         std::function<ResultadoAlineamiento(const std::string&, const std::string&, const ConfiguracionAlineamiento&)> funcion;
+        MotorConEspacio con_espacio;
     };
     
     std::vector<MetodoPrueba> metodos;
+    if (config.puntuacion.gapAfin()) {
+        if (xdrop > 0) {
+            std::cerr << "Aviso: la poda X-drop/Z-drop no admite gap afin; se ignora\n";
+            xdrop = 0;
+        }
+        if (ejecutar_secuencial) {
+            metodos.push_back({"afin" + sufijo_cigar, nullptr, alineamientoNWAfin});
+        }
+        if (ejecutar_puntuacion) {
+            metodos.push_back({"puntuacion_afin", nullptr, puntuacionNWAfin});
+        }
+        if (ejecutar_bloques) {
+            metodos.push_back({"afin_bloques" + sufijo_cigar, nullptr, alineamientoNWParaleloAfinBloques});
+        }
+        if (ejecutar_antidiagonal_persistente) {
+            metodos.push_back({"afin_antidiagonal" + sufijo_cigar, nullptr,
+                               alineamientoNWParaleloAfinAntidiagonal});
+        }
+        if (ejecutar_puntuacion_simd || ejecutar_antidiagonal || ejecutar_antidiagonal_simd ||
+            ejecutar_tareas || ejecutar_franjas || ejecutar_hirschberg || ejecutar_bitparalelo || ejecutar_banda) {
+            std::cerr << "Aviso: con -g solo se ejecutan -s, -S, -b y -w (los demas motores usan gap lineal)\n";
+        }
+        // Los motores lineales ignoran la apertura: no se ejecutan
+        ejecutar_secuencial = ejecutar_puntuacion = ejecutar_puntuacion_simd = false;
+        ejecutar_antidiagonal = ejecutar_antidiagonal_simd = ejecutar_antidiagonal_persistente = false;
+        ejecutar_bloques = ejecutar_tareas = ejecutar_franjas = false;
+        ejecutar_hirschberg = ejecutar_bitparalelo = ejecutar_banda = false;
+    }
+    if (xdrop > 0 && (ejecutar_secuencial || ejecutar_antidiagonal)) {
+        if (usar_direcciones) {
+            std::cerr << "Aviso: -D se ignora en -s y -a con poda X-drop/Z-drop\n";
+        }
+        if (ejecutar_secuencial) {
+            metodos.push_back({"secuencial" + sufijo_poda,
+                               [xdrop, zdrop](const std::string& a, const std::string& b, const ConfiguracionAlineamiento& c) {
+                                   ConfiguracionAlineamiento con_poda = c;
+                                   con_poda.xdrop = xdrop;
+                                   con_poda.zdrop = zdrop;
+                                   return AlgNW(a, b, con_poda);
+                               }, nullptr});
+        }
+        if (ejecutar_antidiagonal) {
+            metodos.push_back({"antidiagonal" + sufijo_poda,
+                               [xdrop, zdrop](const std::string& a, const std::string& b, const ConfiguracionAlineamiento& c) {
+                                   ConfiguracionAlineamiento con_poda = c;
+                                   con_poda.xdrop = xdrop;
+                                   con_poda.zdrop = zdrop;
+                                   return alineamientoNWParaleloAntidiagonal(a, b, con_poda);
+                               }, nullptr});
+        }
+        ejecutar_secuencial = ejecutar_antidiagonal = false;
+    } else if (xdrop > 0) {
+        std::cerr << "Aviso: la poda X-drop/Z-drop solo se aplica a -s y -a\n";
+    }
     if (ejecutar_secuencial) {
-        metodos.push_back({"secuencial", AlgNW});
+        metodos.push_back({"secuencial" + sufijo_dir, nullptr, AlgNW});
+    }
+    if (ejecutar_puntuacion) {
+        metodos.push_back({"puntuacion", nullptr, puntuacionNW});
+    }
+    if (ejecutar_puntuacion_simd) {
+        metodos.push_back({"puntuacion_simd",
+                           [](const std::string& a, const std::string& b, const ConfiguracionAlineamiento& c) {
+                               return puntuacionNWSimd(a, b, c);
+                           }, nullptr});
     }
     if (ejecutar_antidiagonal) {
-        metodos.push_back({"antidiagonal", alineamientoNWParaleloAntidiagonal});
+        metodos.push_back({"antidiagonal" + sufijo_dir, nullptr, alineamientoNWParaleloAntidiagonal});
+    }
+    if (ejecutar_antidiagonal_simd) {
+        metodos.push_back({"antidiagonal_simd" + sufijo_cigar, nullptr, alineamientoNWParaleloAntidiagonalSIMD});
+    }
+    if (ejecutar_antidiagonal_persistente) {
+        metodos.push_back({"antidiagonal_persistente" + sufijo_cigar, nullptr,
+                           alineamientoNWParaleloAntidiagonalPersistente});
     }
     if (ejecutar_bloques) {
-        metodos.push_back({"bloques", alineamientoNWParaleloBloques});
+        metodos.push_back({"bloques" + sufijo_dir, nullptr, alineamientoNWParaleloBloques});
+    }
+    if (ejecutar_tareas) {
+        metodos.push_back({"tareas" + sufijo_cigar, nullptr, alineamientoNWParaleloTareas});
+    }
+    if (ejecutar_franjas) {
+        metodos.push_back({"franjas" + sufijo_cigar, nullptr, alineamientoNWParaleloFranjas});
+    }
+    if (ejecutar_hirschberg) {
+        metodos.push_back({"hirschberg" + sufijo_cigar, alineamientoNWHirschberg, nullptr});
+    }
+    if (ejecutar_bitparalelo) {
+        if (!config.puntuacion.equivalenteDistanciaEdicion()) {
+            std::cerr << "Aviso: el esquema no equivale a distancia de edicion; bitparalelo usa el motor secuencial\n";
+        }
+        metodos.push_back({"bitparalelo" + sufijo_cigar, alineamientoNWBitParalelo, nullptr});
+    }
+    if (ejecutar_banda) {
+        metodos.push_back({"banda_adaptativa" + sufijo_cigar,
+                           [](const std::string& a, const std::string& b, const ConfiguracionAlineamiento& c) {
+                               return alineamientoNWBandaAdaptativa(a, b, c);
+                           }, nullptr});
+    }
+    
+    if (usar_iupac) {
+        for (auto& metodo : metodos) {
+            metodo.nombre += "_iupac";
+        }
     }
     
     std::cout << "=== EJECUTANDO BENCHMARK ===\n";
@@ -285,18 +1011,39 @@ int main(int argc, char* argv[]) {
     
     for (const auto& metodo : metodos) {
         std::cout << "--- Metodo: " << metodo.nombre << " ---\n";
-        std::cout << "  Ejecutando... ";
-        std::cout.flush();
-        
-        ResultadoAlineamiento resultado = ejecutarConLimpiezaCache(
-            metodo.funcion, secA, secB, config);
-        
-        guardarResultadosCSV(archivo_salida, archivo_fasta, metodo.nombre, 
-                           resultado, match, mismatch, gap, 1, num_threads, schedule_str);
-        
-        double tiempo_total = resultado.tiempo_fase1_ms + resultado.tiempo_fase2_ms + resultado.tiempo_fase3_ms;
-        std::cout << "Tiempo: " << std::fixed << std::setprecision(2) 
-                  << tiempo_total << " ms, Puntuacion: " << resultado.puntuacion << "\n";
+        // Un espacio por método: la repetición 1 reserva como siempre y las
+        // siguientes reutilizan su memoria
+        EspacioTrabajo espacio;
+        auto funcion = metodo.funcion;
+        if (metodo.con_espacio != nullptr) {
+            MotorConEspacio motor = metodo.con_espacio;
+            funcion = [motor, &espacio](const std::string& a, const std::string& b, const ConfiguracionAlineamiento& c) {
+                return motor(a, b, c, espacio);
+            };
+        }
+        for (int r = 1; r <= repeticiones; ++r) {
+            std::cout << "  Ejecutando";
+            if (repeticiones > 1) std::cout << " (" << r << "/" << repeticiones << ")";
+            std::cout << "... ";
+            std::cout.flush();
+            
+            ResultadoAlineamiento resultado = ejecutarConLimpiezaCache(funcion, secA, secB, config);
+            
+            guardarResultadosCSV(archivo_salida, archivo_fasta, metodo.nombre, 
+                               resultado, match, mismatch, gap, r, num_threads, schedule_str,
+                               secA.length(), secB.length());
+            
+            double tiempo_total = resultado.tiempo_fase1_ms + resultado.tiempo_fase2_ms + resultado.tiempo_fase3_ms;
+            std::cout << "Tiempo: " << std::fixed << std::setprecision(2) 
+                      << tiempo_total << " ms, Puntuacion: " << resultado.puntuacion << "\n";
+            if (resultado.celdas_omitidas > 0 || resultado.truncado) {
+                std::cout << "  Poda: " << resultado.celdas_omitidas << " celdas omitidas"
+                          << (resultado.truncado ? ", alineamiento truncado" : "") << "\n";
+            }
+        }
+        if (metodo.con_espacio != nullptr && repeticiones > 1) {
+            std::cout << "  Espacio de trabajo: " << espacio.bytes() / (1024.0 * 1024.0) << " MB\n";
+        }
     }
     std::cout << "\n";
     
@@ -3,7 +3,7 @@
  * @brief Programa para ejecutar el algoritmo Needleman-Wunsch de forma secuencial (DNA)
  * 
  * Uso:
- *   ./main-secuencial -f archivo.fasta -p <match> <mismatch> <gap> [-o salida.csv]
+ *   ./main-secuencial -f archivo.fasta -p <match> <mismatch> <gap> [-S | -V | -B] [-M] [-I] [-g <apertura>] [-X <x> | -Z <z>] [-D] [-C] [-o salida.csv]
  * 
  * Ejemplo:
  *   ./main-secuencial -f datos/test.fasta -p 2 -1 -2 -o resultado.csv
@@ -18,14 +18,24 @@
 #include "tipos.h"
 #include "puntuacion.h"
 #include "secuencial.h"
+#include "simd_estriado.h"
+#include "bitparalelo.h"
+#include "banda.h"
+#include "afin.h"
+#include "traceback.h"
 #include "utilidades.h"
 
 /**
  * @brief Guarda resultados en CSV
+ *
+ * Si el resultado es solo de puntuación (sin alineamiento) se registran las
+ * longitudes de las secuencias de entrada.
  */
 void guardarCSV(const std::string& archivo_salida,
                 const std::string& archivo_fasta,
+                const std::string& metodo,
                 const ResultadoAlineamiento& resultado,
+                size_t longitud_entrada_A, size_t longitud_entrada_B,
                 int match, int mismatch, int gap) {
     
     std::ofstream csv(archivo_salida, std::ios::app);
@@ -40,22 +50,29 @@ void guardarCSV(const std::string& archivo_salida,
     
     if (archivo_vacio) {
         csv << "archivo_fasta,metodo,repeticion,threads,schedule,longitud_A,longitud_B,match,mismatch,gap";
-        csv << ",tiempo_init_ms,tiempo_llenado_ms,tiempo_traceback_ms,tiempo_total_ms,puntuacion\n";
+        csv << ",tiempo_init_ms,tiempo_llenado_ms,tiempo_traceback_ms,tiempo_total_ms,puntuacion,lugares\n";
     }
     
     double tiempo_total = resultado.tiempo_fase1_ms + resultado.tiempo_fase2_ms + resultado.tiempo_fase3_ms;
     
     csv << archivo_fasta << ",";
-    csv << "secuencial,";  // método
+    csv << metodo << ",";  // método
     csv << "1,";  // repeticion (siempre 1 para secuencial)
     csv << "1,";  // threads (siempre 1 para secuencial)
     csv << "N/A,";  // schedule (no aplica para secuencial)
-    csv << resultado.secA.length() << "," << resultado.secB.length() << ",";
+    if (resultado.solo_puntuacion) {
+        csv << longitud_entrada_A << "," << longitud_entrada_B << ",";
+    } else if (!resultado.cigar.empty()) {
+        csv << longitudCIGAR(resultado.cigar) << "," << longitudCIGAR(resultado.cigar) << ",";
+    } else {
+        csv << resultado.secA.length() << "," << resultado.secB.length() << ",";
+    }
     csv << match << "," << mismatch << "," << gap << ",";
     csv << std::fixed << std::setprecision(4);
     csv << resultado.tiempo_fase1_ms << "," << resultado.tiempo_fase2_ms << "," << resultado.tiempo_fase3_ms << ",";
     csv << tiempo_total << ",";
-    csv << resultado.puntuacion << "\n";
+    csv << resultado.puntuacion << ",";
+    csv << "N/A\n";  // lugares (no aplica para secuencial)
     
     csv.close();
 }
@@ -68,11 +85,23 @@ void mostrarUso(const char* nombre_programa) {
     std::cout << "Opciones:\n";
     std::cout << "  -f <archivo.fasta>    Archivo FASTA con las secuencias DNA (OBLIGATORIO)\n";
     std::cout << "  -p <match> <mismatch> <gap>   Parametros de puntuacion (OBLIGATORIO)\n";
+    std::cout << "  -S                    Solo puntuacion (dos filas, sin traceback)\n";
+    std::cout << "  -V                    Solo puntuacion con kernel SIMD estriado (SSE4.1/AVX2)\n";
+    std::cout << "  -M                    Motor bit-paralelo (Myers) si el esquema equivale a distancia de edicion\n";
+    std::cout << "  -B                    Banda adaptativa: duplica el ancho hasta demostrar el optimo\n";
+    std::cout << "  -I                    Puntuacion IUPAC (R, Y, N, ... puntuan por bases compatibles)\n";
+    std::cout << "  -g <apertura>         Gap afin (Gotoh): un gap de k bases puntua apertura + k*gap\n";
+    std::cout << "  -X <x>                Poda X-drop: descarta celdas mas de x por debajo de la mejor y corta\n";
+    std::cout << "                        el alineamiento si no queda ninguna viva\n";
+    std::cout << "  -Z <z>                Como -X, pero con Z-drop (el umbral se relaja con la distancia en diagonales)\n";
+    std::cout << "  -D                    Traceback con matriz de direcciones de 2 bits (sin matriz de puntuaciones)\n";
+    std::cout << "  -C                    Salida compacta CIGAR en lugar de las secuencias alineadas\n";
     std::cout << "  -o <archivo.csv>      Archivo de salida CSV [default: resultado.csv]\n";
     std::cout << "  -h, --help           Mostrar esta ayuda\n\n";
     std::cout << "Ejemplos:\n";
     std::cout << "  " << nombre_programa << " -f data/test.fasta -p 2 -1 -2\n";
     std::cout << "  " << nombre_programa << " -f data/test.fasta -p 2 -1 -2 -o resultado.csv\n";
+    std::cout << "  " << nombre_programa << " -f data/test.fasta -p 2 -1 -2 -S -o resultado.csv\n";
 }
 
 /**
@@ -84,7 +113,17 @@ int main(int argc, char* argv[]) {
     std::string archivo_fasta = "";
     std::string archivo_salida = "resultado.csv";
     int match = 0, mismatch = 0, gap = 0;
+    int apertura = 0;
+    int xdrop = 0;
+    bool zdrop = false;
     bool parametros_validos = false;
+    bool solo_puntuacion = false;
+    bool usar_simd = false;
+    bool usar_bitparalelo = false;
+    bool usar_banda = false;
+    bool usar_iupac = false;
+    bool usar_direcciones = false;
+    bool usar_cigar = false;
     
     // Parsear argumentos
     for (int i = 1; i < argc; ++i) {
@@ -96,6 +135,35 @@ int main(int argc, char* argv[]) {
         else if (arg == "-o" && i + 1 < argc) {
             archivo_salida = argv[++i];
         }
+        else if (arg == "-S") {
+            solo_puntuacion = true;
+        }
+        else if (arg == "-V") {
+            solo_puntuacion = true;
+            usar_simd = true;
+        }
+        else if (arg == "-M") {
+            usar_bitparalelo = true;
+        }
+        else if (arg == "-B") {
+            usar_banda = true;
+        }
+        else if (arg == "-I") {
+            usar_iupac = true;
+        }
+        else if (arg == "-D") {
+            usar_direcciones = true;
+        }
+        else if (arg == "-C") {
+            usar_cigar = true;
+        }
+        else if (arg == "-g" && i + 1 < argc) {
+            apertura = std::atoi(argv[++i]);
+        }
+        else if ((arg == "-X" || arg == "-Z") && i + 1 < argc) {
+            xdrop = std::atoi(argv[++i]);
+            zdrop = (arg == "-Z");
+        }
         else if (arg == "-p" && i + 3 < argc) {
             match = std::atoi(argv[++i]);
             mismatch = std::atoi(argv[++i]);
@@ -123,25 +191,117 @@ int main(int argc, char* argv[]) {
     
     // Leer secuencias del archivo FASTA
     std::cout << "Leyendo secuencias de " << archivo_fasta << "...\n";
-    std::vector<std::string> secuencias = leerArchivoFasta(archivo_fasta);
+    // Se empaquetan a 2 bits al leer; solo se desempaquetan las dos que se alinean
+    std::vector<SecuenciaDNA> secuencias = leerArchivoFastaDNA(archivo_fasta);
     
     if (secuencias.size() < 2) {
         std::cerr << "Error: El archivo FASTA debe contener al menos 2 secuencias\n";
         return 1;
     }
     
-    std::string secA = secuencias[0];
-    std::string secB = secuencias[1];
+    std::string secA = secuencias[0].desempaquetar();
+    std::string secB = secuencias[1].desempaquetar();
     
     std::cout << "Secuencia A: " << secA.length() << " caracteres\n";
     std::cout << "Secuencia B: " << secB.length() << " caracteres\n";
     std::cout << "Parametros: match=" << match << ", mismatch=" << mismatch << ", gap=" << gap << "\n\n";
     
     ConfiguracionAlineamiento config(match, mismatch, gap, false);
+    config.traceback_direcciones = usar_direcciones;
+    config.salida_cigar = usar_cigar;
+    config.puntuacion.iupac = usar_iupac;
+    config.puntuacion.parametros.apertura = apertura;
+    bool usar_afin = config.puntuacion.gapAfin();
+    
+    if (usar_afin && (usar_simd || usar_bitparalelo || usar_banda)) {
+        std::cerr << "Aviso: -V, -M y -B no admiten gap afin; se usa el motor de Gotoh\n";
+        usar_simd = false;
+        usar_bitparalelo = false;
+        usar_banda = false;
+    }
+    if (usar_banda && (solo_puntuacion || usar_bitparalelo || usar_direcciones)) {
+        std::cerr << "Aviso: -S, -V, -M y -D se ignoran junto con -B\n";
+        solo_puntuacion = false;
+        usar_simd = false;
+        usar_bitparalelo = false;
+        usar_direcciones = false;
+    }
+    if (usar_bitparalelo && usar_simd) {
+        std::cerr << "Aviso: -M se ignora junto con -V\n";
+        usar_bitparalelo = false;
+    }
+    if (xdrop > 0 && (usar_afin || solo_puntuacion || usar_bitparalelo || usar_banda)) {
+        std::cerr << "Aviso: la poda X-drop/Z-drop solo se aplica al alineamiento secuencial; se ignora\n";
+        xdrop = 0;
+    }
+    if (xdrop > 0 && usar_direcciones) {
+        std::cerr << "Aviso: -D se ignora con poda X-drop/Z-drop\n";
+        usar_direcciones = false;
+    }
+    config.xdrop = xdrop;
+    config.zdrop = zdrop;
+    config.traceback_direcciones = usar_direcciones;
+    if (usar_bitparalelo && !config.puntuacion.equivalenteDistanciaEdicion()) {
+        std::cerr << "Aviso: el esquema no equivale a distancia de edicion; -M usa el motor clasico\n";
+    }
     
-    std::cout << "Ejecutando alineamiento secuencial...\n";
+    std::string metodo = usar_simd ? "puntuacion_simd" : (solo_puntuacion ? "puntuacion" : "secuencial");
+    if (usar_bitparalelo) {
+        metodo = solo_puntuacion ? "puntuacion_bitparalelo" : "bitparalelo";
+    }
+    if (usar_banda) {
+        metodo = "banda_adaptativa";
+    }
+    if (usar_afin) {
+        metodo = solo_puntuacion ? "puntuacion_afin" : "afin";
+    }
+    if (usar_direcciones && !solo_puntuacion && !usar_bitparalelo && !usar_afin) {
+        metodo += "_dir";
+    }
+    if (xdrop > 0) {
+        metodo += zdrop ? "_zdrop" : "_xdrop";
+    }
+    if (usar_cigar && !solo_puntuacion) {
+        metodo += "_cigar";
+    }
+    if (usar_iupac) {
+        metodo += "_iupac";
+    }
+    if (usar_simd) {
+        std::cout << "Ejecutando calculo de puntuacion SIMD ("
+                  << nombreConjuntoSimd(detectarConjuntoSimd()) << ", sin traceback)...\n";
+    } else if (usar_afin) {
+        std::cout << "Ejecutando Gotoh (gap afin, apertura=" << apertura << ")"
+                  << (solo_puntuacion ? " sin traceback" : "") << "...\n";
+    } else if (usar_banda) {
+        std::cout << "Ejecutando alineamiento en banda adaptativa (semiancho inicial "
+                  << SEMIANCHO_BANDA_INICIAL << ")...\n";
+    } else if (usar_bitparalelo) {
+        std::cout << "Ejecutando motor bit-paralelo"
+                  << (solo_puntuacion ? " (sin traceback)" : " con traceback en banda") << "...\n";
+    } else if (solo_puntuacion) {
+        std::cout << "Ejecutando calculo de puntuacion (sin traceback, kernel "
+                  << nombreEsquemaFijo(detectarEsquemaFijo(config.puntuacion)) << ")...\n";
+    } else if (xdrop > 0) {
+        std::cout << "Ejecutando alineamiento secuencial con poda " << (zdrop ? "Z-drop" : "X-drop")
+                  << " (umbral " << xdrop << ")...\n";
+    } else if (usar_direcciones) {
+        std::cout << "Ejecutando alineamiento secuencial...\n";
+    } else {
+        std::cout << "Ejecutando alineamiento secuencial (kernel "
+                  << nombreEsquemaFijo(detectarEsquemaFijo(config.puntuacion)) << ")...\n";
+    }
+    int semiancho_final = 0;
     auto inicio = std::chrono::high_resolution_clock::now();
-    ResultadoAlineamiento resultado = AlgNW(secA, secB, config);
+    ResultadoAlineamiento resultado = usar_banda ? alineamientoNWBandaAdaptativa(secA, secB, config,
+                                                                                 SEMIANCHO_BANDA_INICIAL, &semiancho_final)
+                                    : usar_afin ? (solo_puntuacion ? puntuacionNWAfin(secA, secB, config)
+                                                                    : alineamientoNWAfin(secA, secB, config))
+                                    : usar_simd ? puntuacionNWSimd(secA, secB, config)
+                                    : usar_bitparalelo ? (solo_puntuacion ? puntuacionNWBitParalelo(secA, secB, config)
+                                                                          : alineamientoNWBitParalelo(secA, secB, config))
+                                    : solo_puntuacion ? puntuacionNW(secA, secB, config)
+                                                      : AlgNW(secA, secB, config);
     auto fin = std::chrono::high_resolution_clock::now();
     
     double tiempo_total = std::chrono::duration<double, std::milli>(fin - inicio).count();
@@ -149,6 +309,15 @@ int main(int argc, char* argv[]) {
     // Mostrar resultados
     std::cout << "\n=== RESULTADOS ===\n";
     std::cout << "Puntuacion: " << resultado.puntuacion << "\n";
+    if (usar_banda) {
+        std::cout << "Semiancho final de la banda: " << semiancho_final << "\n";
+    }
+    if (xdrop > 0) {
+        std::cout << "Celdas omitidas por la poda: " << resultado.celdas_omitidas << "\n";
+        if (resultado.truncado) {
+            std::cout << "Alineamiento truncado: la puntuacion y el alineamiento corresponden a la mejor celda vista\n";
+        }
+    }
     std::cout << std::fixed << std::setprecision(4);
     std::cout << "Tiempo de inicializacion: " << resultado.tiempo_fase1_ms << " ms\n";
     std::cout << "Tiempo de llenado de matriz: " << resultado.tiempo_fase2_ms << " ms\n";
@@ -156,7 +325,8 @@ int main(int argc, char* argv[]) {
     std::cout << "Tiempo total: " << tiempo_total << " ms\n";
     
     // Guardar resultados en CSV
-    guardarCSV(archivo_salida, archivo_fasta, resultado, match, mismatch, gap);
+    guardarCSV(archivo_salida, archivo_fasta, metodo, resultado, secA.length(), secB.length(),
+               match, mismatch, gap);
     std::cout << "\nResultados guardados en: " << archivo_salida << "\n";
     
     return 0;
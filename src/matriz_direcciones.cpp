@@ -0,0 +1,36 @@
+#include "matriz_direcciones.h"
+#include "matriz_dp.h"
+#include <cstring>
+#include <new>
+
+MatrizDirecciones::MatrizDirecciones()
+    : datos_(nullptr), reservado_(0), filas_(0), columnas_(0), stride_(0) {}
+
+MatrizDirecciones::MatrizDirecciones(int filas, int columnas)
+    : datos_(nullptr), reservado_(0), filas_(0), columnas_(0), stride_(0) {
+    redimensionar(filas, columnas);
+}
+
+void MatrizDirecciones::redimensionar(int filas, int columnas) {
+    filas_ = filas;
+    columnas_ = columnas;
+    // 4 celdas por byte, cada fila rellena hasta múltiplo de línea de caché
+    std::size_t bytes_fila = (static_cast<std::size_t>(columnas) + 3) / 4;
+    stride_ = (bytes_fila + MatrizDP::ALINEACION_BYTES - 1)
+            / MatrizDP::ALINEACION_BYTES * MatrizDP::ALINEACION_BYTES;
+
+    if (bytes() > reservado_ || datos_ == nullptr) {
+        liberarAlineado(datos_);
+        reservado_ = 0;
+        datos_ = static_cast<unsigned char*>(reservarAlineado(MatrizDP::ALINEACION_BYTES, bytes()));
+        if (datos_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        reservado_ = bytes();
+    }
+    std::memset(datos_, 0, bytes());
+}
+
+MatrizDirecciones::~MatrizDirecciones() {
+    liberarAlineado(datos_);
+}
@@ -0,0 +1,167 @@
+#include "matriz_dp.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+void* reservarAlineado(std::size_t alineacion, std::size_t bytes) {
+    if (bytes == 0) bytes = alineacion;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, alineacion);
+#else
+    void* puntero = nullptr;
+    if (posix_memalign(&puntero, alineacion, bytes) != 0) {
+        return nullptr;
+    }
+    return puntero;
+#endif
+}
+
+void* reservarPaginasGrandes(std::size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (bytes >= MatrizDP::BYTES_PAGINA_GRANDE) {
+        // Múltiplo de página grande: la última no queda compartida con otra reserva
+        std::size_t redondeado = (bytes + MatrizDP::BYTES_PAGINA_GRANDE - 1)
+                               / MatrizDP::BYTES_PAGINA_GRANDE * MatrizDP::BYTES_PAGINA_GRANDE;
+        void* puntero = reservarAlineado(MatrizDP::BYTES_PAGINA_GRANDE, redondeado);
+        if (puntero != nullptr) {
+            // Solo es un consejo: si el núcleo no tiene THP se usan páginas normales
+            madvise(puntero, redondeado, MADV_HUGEPAGE);
+        }
+        return puntero;
+    }
+#endif
+    return reservarAlineado(MatrizDP::ALINEACION_BYTES, bytes);
+}
+
+void liberarAlineado(void* puntero) {
+#ifdef _WIN32
+    _aligned_free(puntero);
+#else
+    std::free(puntero);
+#endif
+}
+
+MatrizDP::MatrizDP()
+    : datos_(nullptr), capacidad_(0), reservado_(0), filas_(0), columnas_(0), stride_(0),
+      disposicion_(DISPOSICION_FILAS), log_bloque_(0), mascara_bloque_(0), bloques_j_(0) {}
+
+MatrizDP::MatrizDP(int filas, int columnas, DisposicionMatriz disposicion, int tam_bloque)
+    : datos_(nullptr), capacidad_(0), reservado_(0), filas_(0), columnas_(0), stride_(0),
+      disposicion_(disposicion), log_bloque_(0), mascara_bloque_(0), bloques_j_(0) {
+    redimensionar(filas, columnas, disposicion, tam_bloque);
+    llenar(0);
+}
+
+bool MatrizDP::redimensionar(int filas, int columnas, DisposicionMatriz disposicion, int tam_bloque,
+                             bool paginas_grandes) {
+    filas_ = filas;
+    columnas_ = columnas;
+    disposicion_ = disposicion;
+    log_bloque_ = 0;
+    mascara_bloque_ = 0;
+    bloques_j_ = 0;
+
+    if (disposicion_ == DISPOSICION_FILAS) {
+        // Rellenar cada fila hasta múltiplo de línea de caché
+        stride_ = (static_cast<std::size_t>(columnas) + ENTEROS_POR_LINEA - 1)
+                / ENTEROS_POR_LINEA * ENTEROS_POR_LINEA;
+        capacidad_ = stride_ * filas;
+    } else if (disposicion_ == DISPOSICION_DIAGONALES) {
+        // Cada antidiagonal empieza en línea de caché propia
+        int num_diagonales = (filas > 0 && columnas > 0) ? filas + columnas - 1 : 0;
+        inicio_diagonal_.resize(num_diagonales + 1);
+        std::size_t posicion = 0;
+        for (int d = 0; d < num_diagonales; ++d) {
+            inicio_diagonal_[d] = posicion;
+            int i_min = std::max(0, d - (columnas - 1));
+            int i_max = std::min(filas - 1, d);
+            std::size_t longitud = static_cast<std::size_t>(i_max - i_min + 1);
+            posicion += (longitud + ENTEROS_POR_LINEA - 1) / ENTEROS_POR_LINEA * ENTEROS_POR_LINEA;
+        }
+        inicio_diagonal_[num_diagonales] = posicion;
+        capacidad_ = posicion;
+    } else {
+        // Lado de tesela: potencia de 2 >= una línea de caché
+        int lado = ENTEROS_POR_LINEA;
+        while (lado < tam_bloque) lado <<= 1;
+        while ((1 << log_bloque_) < lado) ++log_bloque_;
+        mascara_bloque_ = lado - 1;
+        std::size_t bloques_i = (static_cast<std::size_t>(filas) + lado - 1) / lado;
+        bloques_j_ = (static_cast<std::size_t>(columnas) + lado - 1) / lado;
+        stride_ = bloques_j_ * lado;
+        capacidad_ = bloques_i * bloques_j_ * lado * lado;
+    }
+
+    // Solo se reserva si el buffer actual no basta
+    if (capacidad_ > reservado_ || datos_ == nullptr) {
+        std::size_t capacidad = capacidad_;
+        liberar();
+        std::size_t bytes = capacidad * sizeof(int);
+        datos_ = static_cast<int*>(paginas_grandes ? reservarPaginasGrandes(bytes)
+                                                   : reservarAlineado(BYTES_PAGINA, bytes));
+        if (datos_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        capacidad_ = capacidad;
+        reservado_ = capacidad;
+        return true;
+    }
+    return false;
+}
+
+MatrizDP::~MatrizDP() {
+    liberar();
+}
+
+MatrizDP::MatrizDP(MatrizDP&& otra)
+    : datos_(otra.datos_), capacidad_(otra.capacidad_), reservado_(otra.reservado_), filas_(otra.filas_),
+      columnas_(otra.columnas_), stride_(otra.stride_), disposicion_(otra.disposicion_),
+      log_bloque_(otra.log_bloque_), mascara_bloque_(otra.mascara_bloque_),
+      bloques_j_(otra.bloques_j_), inicio_diagonal_(std::move(otra.inicio_diagonal_)) {
+    otra.datos_ = nullptr;
+    otra.capacidad_ = 0;
+    otra.reservado_ = 0;
+}
+
+MatrizDP& MatrizDP::operator=(MatrizDP&& otra) {
+    if (this != &otra) {
+        liberar();
+        datos_ = otra.datos_;
+        capacidad_ = otra.capacidad_;
+        reservado_ = otra.reservado_;
+        filas_ = otra.filas_;
+        columnas_ = otra.columnas_;
+        stride_ = otra.stride_;
+        disposicion_ = otra.disposicion_;
+        log_bloque_ = otra.log_bloque_;
+        mascara_bloque_ = otra.mascara_bloque_;
+        bloques_j_ = otra.bloques_j_;
+        inicio_diagonal_ = std::move(otra.inicio_diagonal_);
+        otra.datos_ = nullptr;
+        otra.capacidad_ = 0;
+        otra.reservado_ = 0;
+    }
+    return *this;
+}
+
+void MatrizDP::llenar(int valor) {
+    std::fill(datos_, datos_ + capacidad_, valor);
+}
+
+void MatrizDP::liberar() {
+    if (datos_ != nullptr) {
+        liberarAlineado(datos_);
+        datos_ = nullptr;
+    }
+    capacidad_ = 0;
+    reservado_ = 0;
+}
@@ -1,8 +1,17 @@
 #include "paralelo.h"
 #include "puntuacion.h"
+#include "matriz_dp.h"
+#include "matriz_direcciones.h"
+#include "traceback.h"
+#include "afin.h"
+#include "poda.h"
 #include <vector>
 #include <algorithm>
 #include <chrono>
+#include <cctype>
+#include <atomic>
+#include <new>
+#include <thread>
 #include <omp.h>
 
 // Soporte para eventos de Extrae (opcional)
@@ -10,6 +19,253 @@
 #include <extrae.h>
 #endif
 
+/**
+ * @brief Variante antidiagonal con matriz de direcciones de 2 bits
+ * 
+ * Mantiene solo tres antidiagonales rodantes de puntuación, indexadas por
+ * fila i; cada celda registra su predecesor en D. Dentro de una antidiagonal
+ * cada fila tiene una sola celda, así que los threads nunca escriben el mismo
+ * byte de D.
+ */
+static ResultadoAlineamiento antidiagonalDirecciones(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    MatrizDirecciones& D = espacio.direcciones(m + 1, n + 1);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    // Tabla de sustitución: una carga indexada por celda a lo largo de la antidiagonal
+    TablaSustitucionDNA tabla(config.puntuacion);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    const std::string& codA = espacio.codA;
+    const std::string& codB = espacio.codB;
+    // (*diagonales[k % 3])[i] = F(i, k - i)
+    std::vector<int>* diagonales[3] = {&espacio.anterior, &espacio.actual, &espacio.auxiliar};
+    for (int r = 0; r < 3; ++r) {
+        diagonales[r]->assign(m + 1, 0);
+    }
+    if (m >= 1) (*diagonales[1])[1] = penalidadGap;
+    if (n >= 1) (*diagonales[1])[0] = penalidadGap;
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado de diagonales
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    for (int k = 2; k <= m + n; ++k) {
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, k);
+#endif
+        int* actual = diagonales[k % 3]->data();
+        const int* previa = diagonales[(k - 1) % 3]->data();
+        const int* previa2 = diagonales[(k - 2) % 3]->data();
+        if (k <= m) actual[k] = k * penalidadGap;
+        if (k <= n) actual[0] = k * penalidadGap;
+        
+        int i_min = std::max(1, k - n);
+        int i_max = std::min(m, k - 1);
+        #pragma omp parallel for schedule(runtime) \
+            firstprivate(i_min, i_max, k, actual, previa, previa2)
+        for (int i = i_min; i <= i_max; ++i) {
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, i+1);
+#endif
+            int j = k - i;
+            int coincidencia = previa2[i-1] + tabla(codA[i-1], codB[j-1]);
+            int eliminacion = previa[i-1] + penalidadGap;
+            int insercion = previa[i] + penalidadGap;
+            actual[i] = std::max({coincidencia, eliminacion, insercion});
+            D.fijar(i, j, elegirDireccion(coincidencia, eliminacion, insercion));
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, 0);
+#endif
+        }
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, 0);
+#endif
+    }
+    int puntuacion = (m == 0 || n == 0) ? (m + n) * penalidadGap : (*diagonales[(m + n) % 3])[m];
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackDirecciones(D, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief Variante antidiagonal con poda X-drop/Z-drop (config.xdrop > 0).
+ *
+ * El frente d solo abarca las filas que pueden tener un predecesor vivo en
+ * las antidiagonales d - 1 y d - 2; los threads calculan ese tramo en un
+ * buffer temporal y reducen la mejor puntuación y la primera/última fila
+ * viva. Se guarda el tramo vivo en una MatrizPodada por diagonales y el
+ * llenado se detiene en cuanto un frente queda vacío.
+ */
+static ResultadoAlineamiento antidiagonalPoda(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    TablaSustitucionDNA tabla(config.puntuacion);
+    std::string codA = codificarIUPAC(secA);
+    std::string codB = codificarIUPAC(secB);
+    MatrizPodada F(DISPOSICION_DIAGONALES);
+    CriterioPoda criterio(config, penalidadGap);
+    std::vector<int> tramo(m + 1);
+    F.anadirLinea(0, 0)[0] = 0;
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado de los frentes vivos
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    std::size_t calculadas = 0;
+    int mejor_i = 0, mejor_j = 0;
+    for (int k = 1; k <= m + n; ++k) {
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, k);
+#endif
+        // Predecesores: izquierda en (k-1, i), arriba en (k-1, i-1), diagonal en (k-2, i-1)
+        int primera1 = F.primera(k-1), ultima1 = F.ultima(k-1);
+        const int* previa = F.linea(k-1);
+        int primera2 = 0, ultima2 = -1;
+        const int* previa2 = nullptr;
+        if (k >= 2) {
+            primera2 = F.primera(k-2);
+            ultima2 = F.ultima(k-2);
+            previa2 = F.linea(k-2);
+        }
+        int i_min = std::max(std::max(0, k - n), (k >= 2) ? std::min(primera1, primera2 + 1) : primera1);
+        int i_max = std::min(std::min(m, k), std::max(ultima1, ultima2) + 1);
+        int* frente = tramo.data();
+        
+        int mejor_frente = PODA_MENOS_INFINITO;
+        int primera_viva = m + 1;
+        int ultima_viva = -1;
+        #pragma omp parallel for schedule(runtime) \
+            firstprivate(i_min, i_max, k, frente, previa, previa2, primera1, ultima1, primera2, ultima2) \
+            reduction(max:mejor_frente, ultima_viva) reduction(min:primera_viva)
+        for (int i = i_min; i <= i_max; ++i) {
+            int j = k - i;
+            int coincidencia = PODA_MENOS_INFINITO;
+            if (i - 1 >= primera2 && i - 1 <= ultima2) {
+                coincidencia = previa2[i - 1 - primera2] + tabla(codA[i-1], codB[j-1]);
+            }
+            int eliminacion = (i - 1 >= primera1 && i - 1 <= ultima1) ? previa[i - 1 - primera1] : PODA_MENOS_INFINITO;
+            int insercion = (i >= primera1 && i <= ultima1) ? previa[i - primera1] : PODA_MENOS_INFINITO;
+            int valor = std::max({coincidencia, eliminacion + penalidadGap, insercion + penalidadGap});
+            if (criterio.podar(valor, j - i)) {
+                valor = PODA_MENOS_INFINITO;
+            } else {
+                mejor_frente = std::max(mejor_frente, valor);
+                primera_viva = std::min(primera_viva, i);
+                ultima_viva = std::max(ultima_viva, i);
+            }
+            frente[i - i_min] = valor;
+        }
+        // Celdas interiores (i, j >= 1) del tramo calculado
+        if (i_min <= i_max) {
+            calculadas += (i_max - i_min + 1) - (i_min == 0) - (i_max == k);
+        }
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, 0);
+#endif
+        if (ultima_viva < 0) {
+            F.anadirLineaVacia();
+            break;
+        }
+        std::copy(frente + (primera_viva - i_min), frente + (ultima_viva - i_min) + 1,
+                  F.anadirLinea(primera_viva, ultima_viva));
+        if (mejor_frente > criterio.mejor) {
+            int i = primera_viva;
+            while (frente[i - i_min] != mejor_frente) ++i;
+            criterio.mejor = mejor_frente;
+            criterio.diag_mejor = k - 2 * i;
+            mejor_i = i;
+            mejor_j = k - i;
+        }
+    }
+    // Si (m, n) no sobrevivió, el resultado es el de la mejor celda vista
+    bool truncado = F.valor(m, n) == PODA_MENOS_INFINITO;
+    int fin_i = truncado ? mejor_i : m;
+    int fin_j = truncado ? mejor_j : n;
+    int puntuacion = truncado ? criterio.mejor : F.valor(m, n);
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackPodado(F, fin_i, fin_j, codA, codB, tabla, penalidadGap, secA, secB, config,
+                    alineadaA, alineadaB, cigar);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    ResultadoAlineamiento resultado(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+    resultado.truncado = truncado;
+    resultado.celdas_omitidas = static_cast<std::size_t>(m) * n - calculadas;
+    return resultado;
+}
+
 /**
  * @brief Alineamiento paralelo usando estrategia de antidiagonales
  * 
@@ -33,7 +289,22 @@ ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
     const std::string& secA,
     const std::string& secB,
     const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloAntidiagonal(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
     
+    if (config.xdrop > 0) {
+        return antidiagonalPoda(secA, secB, config);
+    }
+    if (config.traceback_direcciones) {
+        return antidiagonalDirecciones(secA, secB, config, espacio);
+    }
     int m = secA.length();
     int n = secB.length();
     
@@ -42,15 +313,20 @@ ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
 #ifdef HAVE_EXTRAE
     Extrae_event(1000, 1);
 #endif
-    std::vector<std::vector<int>> F(m + 1, std::vector<int>(n + 1, 0));
+    MatrizDP& F = espacio.matriz(m + 1, n + 1);
     int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    TablaSustitucionDNA tabla(config.puntuacion);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    const std::string& codA = espacio.codA;
+    const std::string& codB = espacio.codB;
     
-    F[0][0] = 0;
+    F(0, 0) = 0;
     for (int i = 1; i <= m; ++i) {
-        F[i][0] = F[i-1][0] + penalidadGap;
+        F(i, 0) = F(i-1, 0) + penalidadGap;
     }
     for (int j = 1; j <= n; ++j) {
-        F[0][j] = F[0][j-1] + penalidadGap;
+        F(0, j) = F(0, j-1) + penalidadGap;
     }
     auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
 #ifdef HAVE_EXTRAE
@@ -77,10 +353,10 @@ ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
 #endif
             int j = k - i;
             if (j >= 1 && j <= n) {
-                int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-                int eliminacion = F[i-1][j] + penalidadGap;
-                int insercion = F[i][j-1] + penalidadGap;
-                F[i][j] = std::max({coincidencia, eliminacion, insercion});
+                int coincidencia = F(i-1, j-1) + tabla(codA[i-1], codB[j-1]);
+                int eliminacion = F(i-1, j) + penalidadGap;
+                int insercion = F(i, j-1) + penalidadGap;
+                F(i, j) = std::max({coincidencia, eliminacion, insercion});
             }
 #ifdef HAVE_EXTRAE
             Extrae_event(4000, 0);
@@ -102,47 +378,271 @@ ResultadoAlineamiento alineamientoNWParaleloAntidiagonal(
 #ifdef HAVE_EXTRAE
     Extrae_event(5000, 1);
 #endif
-    std::string alineadaA = "";
-    std::string alineadaB = "";
-    int i = m, j = n;
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief Llena la tesela (bi, bj) de una matriz en disposición por bloques.
+ *
+ * Los bloques coinciden con las teselas de F: la fila/columna 0 pertenece al
+ * primer bloque y no se recalcula. Requiere que las teselas norte, oeste y
+ * noroeste ya estén calculadas. perfil es el perfil de consulta de B
+ * (construirPerfilConsulta) y codA la secuencia A codificada.
+ */
+static void llenarTesela(MatrizDP& F, const std::string& codA, const std::vector<int>& perfil,
+                         int penalidadGap, int bi, int bj) {
+    int tam_bloque = F.tamBloque();
+    int i_inicio = std::max(bi * tam_bloque, 1);
+    int i_fin = std::min((bi + 1) * tam_bloque - 1, F.filas() - 1);
+    int j_inicio = std::max(bj * tam_bloque, 1);
+    int j_fin = std::min((bj + 1) * tam_bloque - 1, F.columnas() - 1);
+    int n = F.columnas() - 1;
+
+    for (int i = i_inicio; i <= i_fin; ++i) {
+        // Dentro de una tesela las celdas de una fila son contiguas
+        const int* arriba = &F(i-1, j_inicio);
+        int* actual = &F(i, j_inicio);
+        int diagonal = F(i-1, j_inicio-1);
+        int izquierda = F(i, j_inicio-1);
+        const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+        for (int j = j_inicio; j <= j_fin; ++j) {
+            int coincidencia = diagonal + perfil_fila[j-1];
+            int eliminacion = arriba[j - j_inicio] + penalidadGap;
+            int insercion = izquierda + penalidadGap;
+            izquierda = std::max({coincidencia, eliminacion, insercion});
+            diagonal = arriba[j - j_inicio];
+            actual[j - j_inicio] = izquierda;
+        }
+    }
+}
+
+/**
+ * @brief true si los threads están fijados a lugares (OMP_PLACES/OMP_PROC_BIND)
+ *        y hay más de uno: entonces tiene sentido colocar la matriz por nodos NUMA.
+ */
+static bool hilosFijados() {
+    return omp_get_max_threads() > 1 && !describirLugaresOpenMP().empty();
+}
+
+/**
+ * @brief Primera escritura de F con reparto fijo: la fila de teselas bi es del thread bi % hilos.
+ *
+ * Cada thread pone a 0 sus filas de teselas (contiguas en memoria), de modo
+ * que en un sistema NUMA el núcleo coloca sus páginas en el nodo de ese
+ * thread; los fallos de página se resuelven aquí, en paralelo, y no en el
+ * frente de onda. Requiere un buffer alineado a página normal: una tesela
+ * ocupa 4 o 16 páginas enteras y ninguna página es de dos dueños (con
+ * páginas grandes, una sola cubriría varias filas de teselas).
+ */
+static void primerContactoTeselas(MatrizDP& F, int num_bloques_i, int num_bloques_j) {
+    std::size_t celdas_fila = static_cast<std::size_t>(num_bloques_j) * F.tamBloque() * F.tamBloque();
+    #pragma omp parallel
+    {
+        int hilos = omp_get_num_threads();
+        for (int bi = omp_get_thread_num(); bi < num_bloques_i; bi += hilos) {
+            std::fill_n(F.tesela(bi, 0), celdas_fila, 0);
+        }
+    }
+}
+
+/**
+ * @brief Fase 2 de alineamientoNWParaleloBloques con el reparto fijo de primerContactoTeselas.
+ *
+ * Una región para todas las antidiagonales de teselas y una barrera por
+ * antidiagonal; en cada una, el thread h calcula las teselas (bi, k - bi)
+ * con bi % hilos == h, es decir, solo teselas de sus filas. Equivale a
+ * schedule(static, 1) sobre bi, con el reparto anclado a bi y no al
+ * primer bi de la antidiagonal.
+ */
+static void llenarTeselasRepartoFijo(MatrizDP& F, const std::string& codA, const std::vector<int>& perfil,
+                                     int penalidadGap, int num_bloques_i, int num_bloques_j) {
+    #pragma omp parallel
+    {
+        int hilo = omp_get_thread_num();
+        int hilos = omp_get_num_threads();
+        for (int k = 0; k <= num_bloques_i + num_bloques_j - 2; ++k) {
+#ifdef HAVE_EXTRAE
+            #pragma omp master
+            Extrae_event(3000, k+1);
+#endif
+            int bi_min = std::max(0, k - (num_bloques_j - 1));
+            int bi_max = std::min(num_bloques_i - 1, k);
+            // Primera fila de la antidiagonal que es de este thread
+            int bi = bi_min + (hilo - bi_min % hilos + hilos) % hilos;
+            for (; bi <= bi_max; bi += hilos) {
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, bi - bi_min + 1);
+#endif
+                llenarTesela(F, codA, perfil, penalidadGap, bi, k - bi);
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, 0);
+#endif
+            }
+            #pragma omp barrier
+#ifdef HAVE_EXTRAE
+            #pragma omp master
+            Extrae_event(3000, 0);
+#endif
+        }
+    }
+}
+
+/**
+ * @brief Variante por bloques con matriz de direcciones de 2 bits
+ * 
+ * No guarda la matriz de puntuaciones: H[j] es la última fila calculada en
+ * la columna j y V[i] la última columna calculada en la fila i; cada bloque
+ * las consume y actualiza en el sitio. esquinas[] guarda la celda inferior
+ * derecha de cada bloque (la diagonal de entrada del bloque siguiente en
+ * diagonal). Los bloques de una misma antidiagonal tocan tramos disjuntos de
+ * H, V y D (sus columnas empiezan en múltiplos de tam_bloque).
+ */
+static ResultadoAlineamiento bloquesDirecciones(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    int tam_bloque,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    int num_bloques_i = m / tam_bloque + 1;
+    int num_bloques_j = n / tam_bloque + 1;
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    MatrizDirecciones& D = espacio.direcciones(m + 1, n + 1);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    // Perfil de consulta: una carga por celda, sin comparar símbolos
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
+    std::vector<int>& H = espacio.anterior;
+    std::vector<int>& V = espacio.actual;
+    std::vector<int>& esquinas = espacio.auxiliar;
+    H.resize(n + 1);
+    V.resize(m + 1);
+    esquinas.assign(static_cast<size_t>(num_bloques_i) * num_bloques_j, 0);
+    for (int j = 0; j <= n; ++j) {
+        H[j] = j * penalidadGap;
+    }
+    for (int i = 0; i <= m; ++i) {
+        V[i] = i * penalidadGap;
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
     
-    while (i > 0 || j > 0) {
-        if (i > 0 && j > 0) {
-            int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-            int eliminacion = (i > 0) ? F[i-1][j] + penalidadGap : -999999;
-            int insercion = (j > 0) ? F[i][j-1] + penalidadGap : -999999;
+    // FASE 2: Llenado por bloques
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    for (int k = 0; k <= num_bloques_i + num_bloques_j - 2; ++k) {
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, k+1);
+#endif
+        int bi_min = std::max(0, k - (num_bloques_j - 1));
+        int bi_max = std::min(num_bloques_i - 1, k);
+        
+        #pragma omp parallel for schedule(runtime) \
+            firstprivate(k)
+        for (int bi = bi_min; bi <= bi_max; ++bi) {
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, bi - bi_min + 1);
+#endif
+            int bj = k - bi;
+            int i_inicio = std::max(bi * tam_bloque, 1);
+            int i_fin = std::min((bi + 1) * tam_bloque - 1, m);
+            int j_inicio = std::max(bj * tam_bloque, 1);
+            int j_fin = std::min((bj + 1) * tam_bloque - 1, n);
             
-            if (F[i][j] == coincidencia) {
-                alineadaA = secA[i-1] + alineadaA;
-                alineadaB = secB[j-1] + alineadaB;
-                i--; j--;
-            } else if (F[i][j] == eliminacion) {
-                alineadaA = secA[i-1] + alineadaA;
-                alineadaB = "-" + alineadaB;
-                i--;
-            } else if (F[i][j] == insercion) {
-                alineadaA = "-" + alineadaA;
-                alineadaB = secB[j-1] + alineadaB;
-                j--;
+            if (i_inicio <= i_fin && j_inicio <= j_fin) {
+                // F(i_inicio-1, j_inicio-1): frontera o esquina del bloque noroeste
+                int diagonal_fila;
+                if (bi == 0) {
+                    diagonal_fila = (j_inicio - 1) * penalidadGap;
+                } else if (bj == 0) {
+                    diagonal_fila = (i_inicio - 1) * penalidadGap;
+                } else {
+                    diagonal_fila = esquinas[(bi - 1) * num_bloques_j + (bj - 1)];
+                }
+                
+                for (int i = i_inicio; i <= i_fin; ++i) {
+                    int diagonal = diagonal_fila;
+                    int izquierda = V[i];
+                    diagonal_fila = V[i];  // F(i, j_inicio-1) es la diagonal de la fila i+1
+                    unsigned char* bytes = D.byte(i, 0);
+                    unsigned int acumulado = 0;
+                    const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+                    for (int j = j_inicio; j <= j_fin; ++j) {
+                        int coincidencia = diagonal + perfil_fila[j-1];
+                        int eliminacion = H[j] + penalidadGap;
+                        int insercion = izquierda + penalidadGap;
+                        diagonal = H[j];
+                        izquierda = std::max({coincidencia, eliminacion, insercion});
+                        H[j] = izquierda;
+                        // j_inicio es múltiplo de 4 (o 1): cada byte pertenece a un solo bloque
+                        acumulado |= elegirDireccion(coincidencia, eliminacion, insercion) << ((j & 3) * 2);
+                        if ((j & 3) == 3 || j == j_fin) {
+                            bytes[j >> 2] = static_cast<unsigned char>(acumulado);
+                            acumulado = 0;
+                        }
+                    }
+                    V[i] = izquierda;
+                }
+                esquinas[bi * num_bloques_j + bj] = V[i_fin];
             }
-        } else if (i > 0) {
-            alineadaA = secA[i-1] + alineadaA;
-            alineadaB = "-" + alineadaB;
-            i--;
-        } else {
-            alineadaA = "-" + alineadaA;
-            alineadaB = secB[j-1] + alineadaB;
-            j--;
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, 0);
+#endif
         }
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, 0);
+#endif
     }
+    int puntuacion = (n == 0) ? V[m] : H[n];
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
     
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackDirecciones(D, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
     auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
 #ifdef HAVE_EXTRAE
     Extrae_event(5000, 0);
 #endif
     double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
     
-    return ResultadoAlineamiento(alineadaA, alineadaB, F[m][n], tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms);
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
 }
 
 /**
@@ -166,6 +666,15 @@ ResultadoAlineamiento alineamientoNWParaleloBloques(
     const std::string& secA,
     const std::string& secB,
     const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloBloques(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloBloques(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
     
     int m = secA.length();
     int n = secB.length();
@@ -176,26 +685,41 @@ ResultadoAlineamiento alineamientoNWParaleloBloques(
     // - Bloques de 64-128 elementos (16-64 KB) permiten que múltiples bloques vivan en L2
     // - Esto reduce conflictos de caché y mejora el paralelismo
     int tam_bloque = std::min(m, n) / (num_threads * 2);
-    // Límites: mínimo 64 (cabe en L1d), máximo 128 (múltiples bloques en L2)
-    if (tam_bloque < 64) tam_bloque = 64;
-    if (tam_bloque > 128) tam_bloque = 128;
-    int num_bloques_i = (m + tam_bloque - 1) / tam_bloque;
-    int num_bloques_j = (n + tam_bloque - 1) / tam_bloque;
+    // Límites: mínimo 64 (cabe en L1d), máximo 128 (múltiples bloques en L2).
+    // Las teselas de MatrizDP son potencia de 2, por lo que solo 64 o 128.
+    tam_bloque = (tam_bloque >= 128) ? 128 : 64;
+    if (config.traceback_direcciones) {
+        return bloquesDirecciones(secA, secB, config, tam_bloque, espacio);
+    }
+    // Los bloques cubren los índices 0..m y 0..n (la fila/columna 0 es frontera)
+    int num_bloques_i = m / tam_bloque + 1;
+    int num_bloques_j = n / tam_bloque + 1;
     
     // FASE 1: Inicialización
     auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
 #ifdef HAVE_EXTRAE
     Extrae_event(1000, 1);
 #endif
-    std::vector<std::vector<int>> F(m + 1, std::vector<int>(n + 1, 0));
+    // Con threads fijados a lugares cada fila de teselas tiene un thread
+    // dueño (primera escritura y llenado) y la matriz usa páginas normales
+    bool reparto_fijo = hilosFijados();
+    MatrizDP& F = espacio.matriz(m + 1, n + 1, DISPOSICION_BLOQUES, tam_bloque, !reparto_fijo);
+    if (reparto_fijo && espacio.matrizSinTocar()) {
+        primerContactoTeselas(F, num_bloques_i, num_bloques_j);
+    }
     int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
     
-    F[0][0] = 0;
+    F(0, 0) = 0;
     for (int i = 1; i <= m; ++i) {
-        F[i][0] = F[i-1][0] + penalidadGap;
+        F(i, 0) = F(i-1, 0) + penalidadGap;
     }
     for (int j = 1; j <= n; ++j) {
-        F[0][j] = F[0][j-1] + penalidadGap;
+        F(0, j) = F(0, j-1) + penalidadGap;
     }
     auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
 #ifdef HAVE_EXTRAE
@@ -209,47 +733,34 @@ ResultadoAlineamiento alineamientoNWParaleloBloques(
     Extrae_event(2000, 1);
 #endif
     
-    for (int k = 0; k <= num_bloques_i + num_bloques_j - 2; ++k) {
+    if (reparto_fijo) {
+        llenarTeselasRepartoFijo(F, codA, perfil, penalidadGap, num_bloques_i, num_bloques_j);
+    } else {
+        for (int k = 0; k <= num_bloques_i + num_bloques_j - 2; ++k) {
 #ifdef HAVE_EXTRAE
-	Extrae_event(3000, k+1);
+		Extrae_event(3000, k+1);
 #endif
-        std::vector<std::pair<int, int>> bloques_en_antidiagonal;
-        for (int bi = 0; bi < num_bloques_i; ++bi) {
-            int bj = k - bi;
-            if (bj >= 0 && bj < num_bloques_j) {
-                bloques_en_antidiagonal.push_back({bi, bj});
-            }
-        }
+            // Bloques (bi, k - bi) de la antidiagonal, sin lista intermedia
+            int bi_min = std::max(0, k - (num_bloques_j - 1));
+            int bi_max = std::min(num_bloques_i - 1, k);
         
-        #pragma omp parallel for schedule(runtime) \
-            firstprivate(k)
-        for (size_t idx = 0; idx < bloques_en_antidiagonal.size(); ++idx) {
+            #pragma omp parallel for schedule(runtime) \
+                firstprivate(k)
+            for (int bi = bi_min; bi <= bi_max; ++bi) {
 #ifdef HAVE_EXTRAE
-            Extrae_event(4000, static_cast<int>(idx) + 1);
+                Extrae_event(4000, bi - bi_min + 1);
 #endif
-            int bi = bloques_en_antidiagonal[idx].first;
-            int bj = bloques_en_antidiagonal[idx].second;
+                int bj = k - bi;
             
-            int i_inicio = bi * tam_bloque + 1;
-            int i_fin = std::min((bi + 1) * tam_bloque, m);
-            int j_inicio = bj * tam_bloque + 1;
-            int j_fin = std::min((bj + 1) * tam_bloque, n);
-            
-            for (int i = i_inicio; i <= i_fin; ++i) {
-                for (int j = j_inicio; j <= j_fin; ++j) {
-                    int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-                    int eliminacion = F[i-1][j] + penalidadGap;
-                    int insercion = F[i][j-1] + penalidadGap;
-                    F[i][j] = std::max({coincidencia, eliminacion, insercion});
-                }
-            }
+                llenarTesela(F, codA, perfil, penalidadGap, bi, bj);
 #ifdef HAVE_EXTRAE
-            Extrae_event(4000, 0);
+                Extrae_event(4000, 0);
 #endif
-        }
+            }
 #ifdef HAVE_EXTRAE
-	Extrae_event(3000, 0);
+		Extrae_event(3000, 0);
 #endif
+        }
     }
     
     auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
@@ -263,46 +774,971 @@ ResultadoAlineamiento alineamientoNWParaleloBloques(
 #ifdef HAVE_EXTRAE
     Extrae_event(5000, 1);
 #endif
-    std::string alineadaA = "";
-    std::string alineadaB = "";
-    int i = m, j = n;
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
     
-    while (i > 0 || j > 0) {
-        if (i > 0 && j > 0) {
-            int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-            int eliminacion = (i > 0) ? F[i-1][j] + penalidadGap : -999999;
-            int insercion = (j > 0) ? F[i][j-1] + penalidadGap : -999999;
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+
+/**
+ * @brief Alineamiento paralelo por antidiagonales con almacenamiento sesgado y SIMD
+ * 
+ * Solo paraleliza la fase 2 (llenado de matriz).
+ * 
+ * MEJORAS IMPLEMENTADAS:
+ * - Matriz en disposición por diagonales: la antidiagonal k y sus dependencias
+ *   (k-1 y k-2) son tramos contiguos, sin accesos con stride de fila
+ * - Secuencias codificadas (IUPAC) una vez; B invertida para que su índice crezca con i
+ * - Puntuación de sustitución por tabla 16 x 16 (sin llamada por celda) para
+ *   permitir "omp parallel for simd": cada thread vectoriza su trozo del frente
+ * 
+ * @param secA Secuencia A (DNA)
+ * @param secB Secuencia B (DNA)
+ * @param config Configuración de alineamiento
+ * @return ResultadoAlineamiento con puntuación y tiempos
+ */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalSIMD(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloAntidiagonalSIMD(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalSIMD(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    MatrizDP& F = espacio.matriz(m + 1, n + 1, DISPOSICION_DIAGONALES);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    // Sin modo iupac la sustitución es binaria: comparar códigos vectoriza sin
+    // gather; con iupac se indexa la tabla 16 x 16
+    bool por_tabla = config.puntuacion.iupac;
+    TablaSustitucionDNA tabla(config.puntuacion);
+    const int* sustitucion = tabla.valores;
+    int coincide = config.puntuacion.parametros.coincidencia;
+    int sustituye = config.puntuacion.parametros.sustitucion;
+    
+    // Códigos IUPAC, B invertida para recorrer la antidiagonal hacia delante
+    codificarIUPAC(secA, espacio.codA);
+    espacio.codB.assign(secB.rbegin(), secB.rend());
+    codificarIUPAC(espacio.codB, espacio.codB);
+    const std::string& codA = espacio.codA;
+    const std::string& invB = espacio.codB;
+    
+    F(0, 0) = 0;
+    for (int i = 1; i <= m; ++i) {
+        F(i, 0) = F(i-1, 0) + penalidadGap;
+    }
+    for (int j = 1; j <= n; ++j) {
+        F(0, j) = F(0, j-1) + penalidadGap;
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado de matriz
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    for (int k = 2; k <= m + n; ++k) {
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, k);
+#endif
+        int i_min = std::max(1, k - n);
+        int i_max = std::min(m, k - 1);
+        int longitud = i_max - i_min + 1;
+        // Celda (i_min, k-i_min) y sus vecinas en las dos diagonales previas:
+        // previa[t] = F(i-1, j), previa[t+1] = F(i, j-1), previa2[t] = F(i-1, j-1)
+        int* actual = F.diagonal(k) + (i_min - F.primeraFilaDiagonal(k));
+        const int* previa = F.diagonal(k-1) + (i_min - 1 - F.primeraFilaDiagonal(k-1));
+        const int* previa2 = F.diagonal(k-2) + (i_min - 1 - F.primeraFilaDiagonal(k-2));
+        const char* baseA = codA.data() + (i_min - 1);        // secA[i-1]
+        const char* baseB = invB.data() + (n - k + i_min);    // secB[k-i-1]
+        if (por_tabla) {
+            #pragma omp parallel for simd schedule(runtime) \
+                firstprivate(longitud, actual, previa, previa2, baseA, baseB, sustitucion, penalidadGap)
+            for (int t = 0; t < longitud; ++t) {
+                int coincidencia = previa2[t] + sustitucion[baseA[t] * TAM_ALFABETO_IUPAC + baseB[t]];
+                int eliminacion = previa[t] + penalidadGap;
+                int insercion = previa[t+1] + penalidadGap;
+                actual[t] = std::max(coincidencia, std::max(eliminacion, insercion));
+            }
+        } else {
+            #pragma omp parallel for simd schedule(runtime) \
+                firstprivate(longitud, actual, previa, previa2, baseA, baseB, coincide, sustituye, penalidadGap)
+            for (int t = 0; t < longitud; ++t) {
+                // El código 0 (símbolo desconocido) nunca coincide
+                bool iguales = baseA[t] == baseB[t] && baseA[t] != 0;
+                int coincidencia = previa2[t] + (iguales ? coincide : sustituye);
+                int eliminacion = previa[t] + penalidadGap;
+                int insercion = previa[t+1] + penalidadGap;
+                actual[t] = std::max(coincidencia, std::max(eliminacion, insercion));
+            }
+        }
+#ifdef HAVE_EXTRAE
+	Extrae_event(3000, 0);
+#endif
+    }
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+// Tramo mínimo de antidiagonal por thread en la región persistente
+static const int MIN_CELDAS_POR_HILO = 64;
+
+/**
+ * @brief Alineamiento por antidiagonales con una única región paralela
+ * 
+ * Solo paraleliza la fase 2 (llenado de matriz).
+ * 
+ * MEJORAS IMPLEMENTADAS:
+ * - Un solo "omp parallel" para todas las antidiagonales (sin fork/join por diagonal)
+ * - Reparto estático calculado por cada thread: sin planificador en tiempo de ejecución
+ * - Una barrera por antidiagonal como única sincronización
+ * - Antidiagonales cortas repartidas entre menos threads (tramo mínimo MIN_CELDAS_POR_HILO)
+ * 
+ * @param secA Secuencia A (DNA)
+ * @param secB Secuencia B (DNA)
+ * @param config Configuración de alineamiento
+ * @return ResultadoAlineamiento con puntuación y tiempos
+ */
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalPersistente(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloAntidiagonalPersistente(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAntidiagonalPersistente(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    MatrizDP& F = espacio.matriz(m + 1, n + 1, DISPOSICION_DIAGONALES);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    bool por_tabla = config.puntuacion.iupac;
+    TablaSustitucionDNA tabla(config.puntuacion);
+    const int* sustitucion = tabla.valores;
+    int coincide = config.puntuacion.parametros.coincidencia;
+    int sustituye = config.puntuacion.parametros.sustitucion;
+    
+    codificarIUPAC(secA, espacio.codA);
+    espacio.codB.assign(secB.rbegin(), secB.rend());
+    codificarIUPAC(espacio.codB, espacio.codB);
+    const std::string& codA = espacio.codA;
+    const std::string& invB = espacio.codB;
+    
+    F(0, 0) = 0;
+    for (int i = 1; i <= m; ++i) {
+        F(i, 0) = F(i-1, 0) + penalidadGap;
+    }
+    for (int j = 1; j <= n; ++j) {
+        F(0, j) = F(0, j-1) + penalidadGap;
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado de matriz
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    const char* pA = codA.data();
+    const char* pB = invB.data();
+    #pragma omp parallel firstprivate(m, n, pA, pB, por_tabla, sustitucion, coincide, sustituye, penalidadGap)
+    {
+        int num_hilos = omp_get_num_threads();
+        int id = omp_get_thread_num();
+        
+        for (int k = 2; k <= m + n; ++k) {
+            int i_min = std::max(1, k - n);
+            int i_max = std::min(m, k - 1);
+            int longitud = i_max - i_min + 1;
+            int activos = std::min(num_hilos, (longitud + MIN_CELDAS_POR_HILO - 1) / MIN_CELDAS_POR_HILO);
+            
+            if (id < activos) {
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, k);
+#endif
+                int inicio = static_cast<int>(static_cast<long long>(longitud) * id / activos);
+                int fin = static_cast<int>(static_cast<long long>(longitud) * (id + 1) / activos);
+                int* actual = F.diagonal(k) + (i_min - F.primeraFilaDiagonal(k));
+                const int* previa = F.diagonal(k-1) + (i_min - 1 - F.primeraFilaDiagonal(k-1));
+                const int* previa2 = F.diagonal(k-2) + (i_min - 1 - F.primeraFilaDiagonal(k-2));
+                const char* baseA = pA + (i_min - 1);
+                const char* baseB = pB + (n - k + i_min);
+                if (por_tabla) {
+                    #pragma omp simd
+                    for (int t = inicio; t < fin; ++t) {
+                        int coincidencia = previa2[t] + sustitucion[baseA[t] * TAM_ALFABETO_IUPAC + baseB[t]];
+                        int eliminacion = previa[t] + penalidadGap;
+                        int insercion = previa[t+1] + penalidadGap;
+                        actual[t] = std::max(coincidencia, std::max(eliminacion, insercion));
+                    }
+                } else {
+                    #pragma omp simd
+                    for (int t = inicio; t < fin; ++t) {
+                        bool iguales = baseA[t] == baseB[t] && baseA[t] != 0;
+                        int coincidencia = previa2[t] + (iguales ? coincide : sustituye);
+                        int eliminacion = previa[t] + penalidadGap;
+                        int insercion = previa[t+1] + penalidadGap;
+                        actual[t] = std::max(coincidencia, std::max(eliminacion, insercion));
+                    }
+                }
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, 0);
+#endif
+            }
+            #pragma omp barrier
+        }
+    }
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief Alineamiento paralelo por bloques con tareas OpenMP y dependencias
+ * 
+ * Solo paraleliza la fase 2 (llenado de matriz).
+ * Cada tesela es una tarea que depende de sus vecinas norte, oeste y
+ * noroeste (cláusulas depend), de modo que empieza en cuanto sus entradas
+ * están listas: no hay barrera por antidiagonal de bloques ni vectores
+ * temporales por antidiagonal. OMP_SCHEDULE no se utiliza.
+ * 
+ * @param secA Secuencia A (DNA)
+ * @param secB Secuencia B (DNA)
+ * @param config Configuración de alineamiento
+ * @return ResultadoAlineamiento con puntuación y tiempos
+ */
+ResultadoAlineamiento alineamientoNWParaleloTareas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloTareas(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloTareas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    int num_threads = omp_get_max_threads();
+    // Mismo criterio de tamaño de tesela que alineamientoNWParaleloBloques
+    int tam_bloque = std::min(m, n) / (num_threads * 2);
+    tam_bloque = (tam_bloque >= 128) ? 128 : 64;
+    int num_bloques_i = m / tam_bloque + 1;
+    int num_bloques_j = n / tam_bloque + 1;
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    MatrizDP& F = espacio.matriz(m + 1, n + 1, DISPOSICION_BLOQUES, tam_bloque);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
+    
+    F(0, 0) = 0;
+    for (int i = 1; i <= m; ++i) {
+        F(i, 0) = F(i-1, 0) + penalidadGap;
+    }
+    for (int j = 1; j <= n; ++j) {
+        F(0, j) = F(0, j-1) + penalidadGap;
+    }
+    // Un testigo por tesela para las cláusulas depend; la fila y la columna 0
+    // son centinelas (nunca se escriben) para las teselas del borde.
+    int ancho_testigos = num_bloques_j + 1;
+    std::vector<char>& testigos = espacio.testigos;
+    testigos.assign(static_cast<size_t>(num_bloques_i + 1) * ancho_testigos, 0);
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado de matriz por tareas
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    // depend exige un puntero o array, no un elemento de std::vector
+    char* t = testigos.data();
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            // Las tareas se crean en orden por filas: al crear (bi, bj) ya
+            // existen las tareas norte, oeste y noroeste de las que depende
+            for (int bi = 0; bi < num_bloques_i; ++bi) {
+                for (int bj = 0; bj < num_bloques_j; ++bj) {
+                    int norte = bi * ancho_testigos + (bj + 1);
+                    int oeste = (bi + 1) * ancho_testigos + bj;
+                    int noroeste = bi * ancho_testigos + bj;
+                    int propio = (bi + 1) * ancho_testigos + (bj + 1);
+                    #pragma omp task firstprivate(bi, bj, propio) \
+                        depend(in: t[norte], t[oeste], t[noroeste]) depend(out: t[propio])
+                    {
+#ifdef HAVE_EXTRAE
+                        Extrae_event(4000, bi * num_bloques_j + bj + 1);
+#endif
+                        llenarTesela(F, codA, perfil, penalidadGap, bi, bj);
+                        t[propio] = 1;
+#ifdef HAVE_EXTRAE
+                        Extrae_event(4000, 0);
+#endif
+                    }
+                }
+            }
+        }
+    }
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief Contador de filas publicado por una franja, en línea de caché propia.
+ */
+struct ProgresoFranja {
+    std::atomic<int> fila;
+    char relleno[MatrizDP::ALINEACION_BYTES - sizeof(std::atomic<int>)];
+};
+
+// Iteraciones de espera activa antes de ceder el procesador
+static const int ESPERAS_ANTES_DE_CEDER = 1024;
+
+/**
+ * @brief Alineamiento paralelo por franjas de columnas en tubería (pipeline)
+ * 
+ * Solo paraleliza la fase 2 (llenado de matriz).
+ * Cada thread es dueño de una franja vertical fija de columnas y la recorre
+ * fila a fila. Tras terminar la fila i publica i en su contador; el thread de
+ * la franja derecha espera (activamente) a que ese contador alcance i antes
+ * de calcular su tramo de la fila i. No hay barreras globales: una vez lleno
+ * el pipeline todos los threads trabajan a la vez, desfasados una fila.
+ * 
+ * MEJORAS IMPLEMENTADAS:
+ * - Sincronización punto a punto (acquire/release) solo entre franjas vecinas
+ * - Contadores rellenos a línea de caché para evitar false sharing
+ * - Límites de franja alineados a línea de caché dentro de cada fila de F
+ * 
+ * @param secA Secuencia A (DNA)
+ * @param secB Secuencia B (DNA)
+ * @param config Configuración de alineamiento
+ * @return ResultadoAlineamiento con puntuación y tiempos
+ */
+ResultadoAlineamiento alineamientoNWParaleloFranjas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloFranjas(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloFranjas(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    int num_threads = omp_get_max_threads();
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    MatrizDP& F = espacio.matriz(m + 1, n + 1);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
+    
+    F(0, 0) = 0;
+    for (int i = 1; i <= m; ++i) {
+        F(i, 0) = F(i-1, 0) + penalidadGap;
+    }
+    for (int j = 1; j <= n; ++j) {
+        F(0, j) = F(0, j-1) + penalidadGap;
+    }
+    
+    ProgresoFranja* progreso = static_cast<ProgresoFranja*>(
+        espacio.contadores(num_threads * sizeof(ProgresoFranja)));
+    for (int p = 0; p < num_threads; ++p) {
+        new (&progreso[p].fila) std::atomic<int>(0);
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado de matriz por franjas
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    #pragma omp parallel num_threads(num_threads) firstprivate(m, n, penalidadGap)
+    {
+        int hilos = omp_get_num_threads();
+        int id = omp_get_thread_num();
+        
+        // Franja en unidades de línea de caché: columnas [j_inicio, j_fin]
+        int lineas = (n + 1 + MatrizDP::ENTEROS_POR_LINEA - 1) / MatrizDP::ENTEROS_POR_LINEA;
+        int linea_inicio = static_cast<int>(static_cast<long long>(lineas) * id / hilos);
+        int linea_fin = static_cast<int>(static_cast<long long>(lineas) * (id + 1) / hilos);
+        int j_inicio = std::max(linea_inicio * MatrizDP::ENTEROS_POR_LINEA, 1);
+        int j_fin = std::min(linea_fin * MatrizDP::ENTEROS_POR_LINEA - 1, n);
+        
+#ifdef HAVE_EXTRAE
+        Extrae_event(4000, id + 1);
+#endif
+        for (int i = 1; i <= m; ++i) {
+            // Una franja vacía también espera y publica, para no romper la cadena
+            if (id > 0) {
+                int esperas = 0;
+                while (progreso[id - 1].fila.load(std::memory_order_acquire) < i) {
+                    if (++esperas == ESPERAS_ANTES_DE_CEDER) {
+                        esperas = 0;
+                        std::this_thread::yield();
+                    }
+                }
+            }
             
-            if (F[i][j] == coincidencia) {
-                alineadaA = secA[i-1] + alineadaA;
-                alineadaB = secB[j-1] + alineadaB;
-                i--; j--;
-            } else if (F[i][j] == eliminacion) {
-                alineadaA = secA[i-1] + alineadaA;
-                alineadaB = "-" + alineadaB;
-                i--;
-            } else if (F[i][j] == insercion) {
-                alineadaA = "-" + alineadaA;
-                alineadaB = secB[j-1] + alineadaB;
-                j--;
+            const int* arriba = F.fila(i-1);
+            int* actual = F.fila(i);
+            int diagonal = arriba[j_inicio - 1];
+            int izquierda = actual[j_inicio - 1];
+            const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+            for (int j = j_inicio; j <= j_fin; ++j) {
+                int coincidencia = diagonal + perfil_fila[j-1];
+                int eliminacion = arriba[j] + penalidadGap;
+                int insercion = izquierda + penalidadGap;
+                izquierda = std::max({coincidencia, eliminacion, insercion});
+                diagonal = arriba[j];
+                actual[j] = izquierda;
             }
-        } else if (i > 0) {
-            alineadaA = secA[i-1] + alineadaA;
-            alineadaB = "-" + alineadaB;
-            i--;
+            progreso[id].fila.store(i, std::memory_order_release);
+        }
+#ifdef HAVE_EXTRAE
+        Extrae_event(4000, 0);
+#endif
+    }
+    
+    for (int p = 0; p < num_threads; ++p) {
+        progreso[p].fila.~atomic();
+    }
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAfinBloques(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloAfinBloques(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAfinBloques(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    int num_threads = omp_get_max_threads();
+    // Mismo criterio de tamaño de tesela que alineamientoNWParaleloBloques
+    int tam_bloque = std::min(m, n) / (num_threads * 2);
+    tam_bloque = (tam_bloque >= 128) ? 128 : 64;
+    int num_bloques_i = m / tam_bloque + 1;
+    int num_bloques_j = n / tam_bloque + 1;
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    int gap = config.puntuacion.parametros.gap;
+    int apertura = config.puntuacion.parametros.apertura;
+    int abre = apertura + gap;
+    MatrizEstadosAfin& estados = espacio.estadosAfin(m + 1, n + 1);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
+    // Fronteras rodantes: H y F de la última fila calculada en cada columna,
+    // H y E de la última columna calculada en cada fila
+    std::vector<int>& H = espacio.anterior;
+    std::vector<int>& V = espacio.actual;
+    std::vector<int>& esquinas = espacio.auxiliar;
+    H.resize(n + 1);
+    V.resize(m + 1);
+    esquinas.assign(static_cast<size_t>(num_bloques_i) * num_bloques_j, 0);
+    // F (n + 1 columnas) y E (m + 1 filas), seguidos en el mismo buffer
+    espacio.gaps.assign(static_cast<size_t>(n + 1) + (m + 1), AFIN_MENOS_INFINITO);
+    int* F = espacio.gaps.data();
+    int* E = F + (n + 1);
+    auto frontera = [apertura, gap](int k) { return (k == 0) ? 0 : apertura + k * gap; };
+    for (int j = 0; j <= n; ++j) {
+        H[j] = frontera(j);
+    }
+    for (int i = 0; i <= m; ++i) {
+        V[i] = frontera(i);
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado por bloques
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    for (int k = 0; k <= num_bloques_i + num_bloques_j - 2; ++k) {
+#ifdef HAVE_EXTRAE
+        Extrae_event(3000, k+1);
+#endif
+        int bi_min = std::max(0, k - (num_bloques_j - 1));
+        int bi_max = std::min(num_bloques_i - 1, k);
+        
+        #pragma omp parallel for schedule(runtime) \
+            firstprivate(k, gap, abre)
+        for (int bi = bi_min; bi <= bi_max; ++bi) {
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, bi - bi_min + 1);
+#endif
+            int bj = k - bi;
+            int i_inicio = std::max(bi * tam_bloque, 1);
+            int i_fin = std::min((bi + 1) * tam_bloque - 1, m);
+            int j_inicio = std::max(bj * tam_bloque, 1);
+            int j_fin = std::min((bj + 1) * tam_bloque - 1, n);
+            
+            if (i_inicio <= i_fin && j_inicio <= j_fin) {
+                int diagonal_fila;
+                if (bi == 0) {
+                    diagonal_fila = frontera(j_inicio - 1);
+                } else if (bj == 0) {
+                    diagonal_fila = frontera(i_inicio - 1);
+                } else {
+                    diagonal_fila = esquinas[(bi - 1) * num_bloques_j + (bj - 1)];
+                }
+                
+                for (int i = i_inicio; i <= i_fin; ++i) {
+                    int diagonal = diagonal_fila;
+                    int izquierda = V[i];
+                    int gap_izquierda = E[i];
+                    diagonal_fila = V[i];
+                    unsigned char* fila_estados = estados.fila(i);
+                    const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+                    for (int j = j_inicio; j <= j_fin; ++j) {
+                        int coincidencia = diagonal + perfil_fila[j-1];
+                        int abre_e = izquierda + abre;
+                        int extiende_e = gap_izquierda + gap;
+                        int abre_f = H[j] + abre;
+                        int extiende_f = F[j] + gap;
+                        gap_izquierda = std::max(abre_e, extiende_e);
+                        F[j] = std::max(abre_f, extiende_f);
+                        diagonal = H[j];
+                        izquierda = std::max({coincidencia, gap_izquierda, F[j]});
+                        H[j] = izquierda;
+                        fila_estados[j] = estadoCeldaAfin(coincidencia, abre_e, extiende_e, abre_f, extiende_f);
+                    }
+                    V[i] = izquierda;
+                    E[i] = gap_izquierda;
+                }
+                esquinas[bi * num_bloques_j + bj] = V[i_fin];
+            }
+#ifdef HAVE_EXTRAE
+            Extrae_event(4000, 0);
+#endif
+        }
+#ifdef HAVE_EXTRAE
+        Extrae_event(3000, 0);
+#endif
+    }
+    int puntuacion = (n == 0) ? V[m] : H[n];
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackAfin(estados, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 0);
+#endif
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief Antidiagonal k del motor afín: buffers rodantes indexados por fila i.
+ */
+struct DiagonalAfin {
+    int* H;                   /**< H de la diagonal k. */
+    const int* H1;            /**< H de la diagonal k-1. */
+    const int* H2;            /**< H de la diagonal k-2. */
+    int* E;                   /**< E de la diagonal k. */
+    const int* E1;            /**< E de la diagonal k-1. */
+    int* F;                   /**< F de la diagonal k. */
+    const int* F1;            /**< F de la diagonal k-1. */
+    unsigned char* estados;   /**< Bytes de estado: estados[i - fila0]. */
+    int fila0;                /**< Primera fila de la diagonal en la matriz de estados. */
+    const char* a;            /**< Códigos de A: a[i-1]. */
+    const char* b;            /**< Códigos de B invertida: b[desplazamiento_b + i] = B[k-i-1]. */
+    int desplazamiento_b;
+};
+
+/**
+ * @brief Celdas i en [inicio, fin) de una antidiagonal afín.
+ *
+ * Sin dependencias entre celdas: el bucle se vectoriza con "omp simd".
+ * POR_TABLA = false compara códigos (sin gather); true indexa la tabla IUPAC.
+ */
+template <bool POR_TABLA>
+static void llenarTramoAfin(const DiagonalAfin& d, int inicio, int fin, const int* sustitucion,
+                            int coincide, int sustituye, int gap, int abre) {
+    int* H = d.H;
+    const int* H1 = d.H1;
+    const int* H2 = d.H2;
+    int* E = d.E;
+    const int* E1 = d.E1;
+    int* F = d.F;
+    const int* F1 = d.F1;
+    unsigned char* estados = d.estados - d.fila0;
+    const char* a = d.a - 1;
+    const char* b = d.b + d.desplazamiento_b;
+    #pragma omp simd
+    for (int i = inicio; i < fin; ++i) {
+        int s;
+        if (POR_TABLA) {
+            s = sustitucion[a[i] * TAM_ALFABETO_IUPAC + b[i]];
         } else {
-            alineadaA = "-" + alineadaA;
-            alineadaB = secB[j-1] + alineadaB;
-            j--;
+            // El código 0 (símbolo desconocido) nunca coincide
+            bool iguales = (a[i] == b[i]) & (a[i] != 0);
+            s = iguales ? coincide : sustituye;
         }
+        int coincidencia = H2[i-1] + s;
+        int abre_e = H1[i] + abre;
+        int extiende_e = E1[i] + gap;
+        int abre_f = H1[i-1] + abre;
+        int extiende_f = F1[i-1] + gap;
+        int e = std::max(abre_e, extiende_e);
+        int f = std::max(abre_f, extiende_f);
+        E[i] = e;
+        F[i] = f;
+        H[i] = std::max(coincidencia, std::max(e, f));
+        estados[i] = estadoCeldaAfin(coincidencia, abre_e, extiende_e, abre_f, extiende_f);
     }
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAfinAntidiagonal(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return alineamientoNWParaleloAfinAntidiagonal(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento alineamientoNWParaleloAfinAntidiagonal(
+    const std::string& secA,
+    const std::string& secB,
+    const ConfiguracionAlineamiento& config,
+    EspacioTrabajo& espacio) {
+    
+    int m = secA.length();
+    int n = secB.length();
+    
+    // FASE 1: Inicialización
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 1);
+#endif
+    int gap = config.puntuacion.parametros.gap;
+    int apertura = config.puntuacion.parametros.apertura;
+    int abre = apertura + gap;
+    bool por_tabla = config.puntuacion.iupac;
+    TablaSustitucionDNA tabla(config.puntuacion);
+    const int* sustitucion = tabla.valores;
+    int coincide = config.puntuacion.parametros.coincidencia;
+    int sustituye = config.puntuacion.parametros.sustitucion;
+    MatrizEstadosAfin& estados = espacio.estadosAfin(m + 1, n + 1, DISPOSICION_DIAGONALES);
+    
+    codificarIUPAC(secA, espacio.codA);
+    espacio.codB.assign(secB.rbegin(), secB.rend());
+    codificarIUPAC(espacio.codB, espacio.codB);
+    const std::string& codA = espacio.codA;
+    const std::string& invB = espacio.codB;
+    
+    // Antidiagonales rodantes indexadas por fila i: H[k % 3], E[k % 2], F[k % 2]
+    std::vector<int>* bufH[3] = {&espacio.anterior, &espacio.actual, &espacio.auxiliar};
+    for (int r = 0; r < 3; ++r) {
+        bufH[r]->assign(m + 1, 0);
+    }
+    // E y F: cuatro diagonales de m + 1 seguidas en el mismo buffer
+    std::size_t largo = static_cast<std::size_t>(m) + 1;
+    espacio.gaps.assign(4 * largo, AFIN_MENOS_INFINITO);
+    int* H[3] = {bufH[0]->data(), bufH[1]->data(), bufH[2]->data()};
+    int* E[2] = {espacio.gaps.data(), espacio.gaps.data() + largo};
+    int* F[2] = {espacio.gaps.data() + 2 * largo, espacio.gaps.data() + 3 * largo};
+    // Diagonales 0 y 1: H(0, 0), H(0, 1) y H(1, 0)
+    H[0][0] = 0;
+    if (n >= 1) H[1][0] = apertura + gap;
+    if (m >= 1) H[1][1] = apertura + gap;
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(1000, 0);
+#endif
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    // FASE 2: Llenado por antidiagonales
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    const char* pA = codA.data();
+    const char* pB = invB.data();
+    #pragma omp parallel firstprivate(m, n, pA, pB, por_tabla, sustitucion, coincide, sustituye, gap, apertura, abre)
+    {
+        int num_hilos = omp_get_num_threads();
+        int id = omp_get_thread_num();
+        
+        for (int k = 2; k <= m + n; ++k) {
+            int* Hk = H[k % 3];
+            const int* Hk1 = H[(k - 1) % 3];
+            const int* Hk2 = H[(k - 2) % 3];
+            int* Ek = E[k % 2];
+            const int* Ek1 = E[(k - 1) % 2];
+            int* Fk = F[k % 2];
+            const int* Fk1 = F[(k - 1) % 2];
+            int i_min = std::max(1, k - n);
+            int i_max = std::min(m, k - 1);
+            int longitud = i_max - i_min + 1;
+            int activos = std::min(num_hilos, (longitud + MIN_CELDAS_POR_HILO - 1) / MIN_CELDAS_POR_HILO);
+            
+            if (id == 0) {
+                // Fronteras de la diagonal k: (0, k) y (k, 0), fuera del tramo interior
+                if (k <= n) {
+                    Hk[0] = apertura + k * gap;
+                    Fk[0] = AFIN_MENOS_INFINITO;
+                }
+                if (k <= m) {
+                    Hk[k] = apertura + k * gap;
+                    Ek[k] = AFIN_MENOS_INFINITO;
+                }
+            }
+            if (id < activos) {
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, k);
+#endif
+                int inicio = i_min + static_cast<int>(static_cast<long long>(longitud) * id / activos);
+                int fin = i_min + static_cast<int>(static_cast<long long>(longitud) * (id + 1) / activos);
+                DiagonalAfin d = {Hk, Hk1, Hk2, Ek, Ek1, Fk, Fk1,
+                                  estados.diagonal(k), estados.primeraFilaDiagonal(k),
+                                  pA, pB, n - k};
+                if (por_tabla) {
+                    llenarTramoAfin<true>(d, inicio, fin, sustitucion, coincide, sustituye, gap, abre);
+                } else {
+                    llenarTramoAfin<false>(d, inicio, fin, sustitucion, coincide, sustituye, gap, abre);
+                }
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, 0);
+#endif
+            }
+            #pragma omp barrier
+        }
+    }
+    int puntuacion = H[(m + n) % 3][m];
+    
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
     
+    // FASE 3: Traceback
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+#ifdef HAVE_EXTRAE
+    Extrae_event(5000, 1);
+#endif
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackAfin(estados, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
     auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
 #ifdef HAVE_EXTRAE
     Extrae_event(5000, 0);
 #endif
     double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
     
-    return ResultadoAlineamiento(alineadaA, alineadaB, F[m][n], tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms);
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
 }
 
+std::string describirLugaresOpenMP() {
+#if defined(_OPENMP) && _OPENMP >= 201511
+    int lugares = omp_get_num_places();
+    const char* politica = nullptr;
+    switch (omp_get_proc_bind()) {
+        case omp_proc_bind_master: politica = "master"; break;
+        case omp_proc_bind_close: politica = "close"; break;
+        case omp_proc_bind_spread: politica = "spread"; break;
+        case omp_proc_bind_true: politica = "true"; break;
+        default: break;
+    }
+    if (lugares > 0 && politica != nullptr) {
+        return "places=" + std::to_string(lugares) + "/" + politica;
+    }
+#endif
+    return "";
+}
@@ -0,0 +1,43 @@
+#include "poda.h"
+#include "puntuacion.h"
+#include "traceback.h"
+#include <algorithm>
+
+int* MatrizPodada::anadirLinea(int primera, int ultima) {
+    std::size_t inicio = datos_.size();
+    std::size_t longitud = (ultima >= primera) ? static_cast<std::size_t>(ultima - primera + 1) : 0;
+    inicio_.push_back(inicio);
+    primera_.push_back(primera);
+    ultima_.push_back(ultima);
+    datos_.resize(inicio + longitud);
+    return datos_.data() + inicio;
+}
+
+void tracebackPodado(const MatrizPodada& F, int i, int j,
+                     const std::string& codA, const std::string& codB,
+                     const TablaSustitucionDNA& tabla, int penalidadGap,
+                     const std::string& secA, const std::string& secB,
+                     const ConfiguracionAlineamiento& config,
+                     std::string& alineadaA, std::string& alineadaB,
+                     std::string& cigar) {
+    std::string pasos;
+    pasos.reserve(static_cast<std::size_t>(i) + j);
+    while (i > 0 && j > 0) {
+        int actual = F.valor(i, j);
+        // Los vecinos podados valen -infinito y nunca igualan a una celda viva
+        if (actual == F.valor(i-1, j-1) + tabla(codA[i-1], codB[j-1])) {
+            pasos.push_back(PASO_DIAGONAL);
+            --i; --j;
+        } else if (actual == F.valor(i-1, j) + penalidadGap) {
+            pasos.push_back(PASO_ARRIBA);
+            --i;
+        } else {
+            pasos.push_back(PASO_IZQUIERDA);
+            --j;
+        }
+    }
+    pasos.append(i, PASO_ARRIBA);
+    pasos.append(j, PASO_IZQUIERDA);
+
+    construirSalidaTraceback(pasos, secA, secB, config, alineadaA, alineadaB, cigar);
+}
@@ -1,18 +1,144 @@
 #include "puntuacion.h"
-#include <cctype>
+#include "secuencia_dna.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Tabla byte -> código IUPAC de 4 bits.
+ */
+struct TablaCodigosIUPAC {
+    unsigned char codigo[256];
+
+    TablaCodigosIUPAC() {
+        for (int c = 0; c < 256; ++c) {
+            codigo[c] = 0;
+        }
+        const char* simbolos = "ACGTURYSWKMBDHVN";
+        const unsigned char codigos[] = {1, 2, 4, 8, 8, 5, 10, 6, 9, 12, 3, 14, 13, 11, 7, 15};
+        for (int k = 0; simbolos[k] != '\0'; ++k) {
+            unsigned char s = static_cast<unsigned char>(simbolos[k]);
+            codigo[s] = codigos[k];
+            codigo[s - 'A' + 'a'] = codigos[k];
+        }
+    }
+};
+
+static const TablaCodigosIUPAC TABLA_IUPAC;
+
+static int contarBases(unsigned int codigo) {
+    return (codigo & 1) + ((codigo >> 1) & 1) + ((codigo >> 2) & 1) + ((codigo >> 3) & 1);
+}
+
+int ConfiguracionPuntuacionDNA::puntuacionCodigos(unsigned char a, unsigned char b) const {
+    if (a == 0 || b == 0) {
+        return parametros.sustitucion;
+    }
+    if (!iupac) {
+        return (a == b) ? parametros.coincidencia : parametros.sustitucion;
+    }
+    // Media sobre los pares de bases representados por a y b
+    int pares = contarBases(a) * contarBases(b);
+    int coincidentes = contarBases(a & b);
+    double media = static_cast<double>(coincidentes * parametros.coincidencia
+                                       + (pares - coincidentes) * parametros.sustitucion) / pares;
+    return static_cast<int>(std::lround(media));
+}
+
+TablaSustitucionDNA::TablaSustitucionDNA(const ConfiguracionPuntuacionDNA& config) {
+    for (int a = 0; a < TAM_ALFABETO_IUPAC; ++a) {
+        for (int b = 0; b < TAM_ALFABETO_IUPAC; ++b) {
+            valores[a * TAM_ALFABETO_IUPAC + b] = config.puntuacionCodigos(a, b);
+        }
+    }
+}
 
 int obtenerPuntuacionDNA(char a, char b, const ConfiguracionPuntuacionDNA& config) {
-    a = std::toupper(a);
-    b = std::toupper(b);
-    
-    if (a == b) {
-        return config.parametros.coincidencia;
+    return config.puntuacionCodigos(codigoIUPAC(a), codigoIUPAC(b));
+}
+
+unsigned char codigoIUPAC(char c) {
+    return TABLA_IUPAC.codigo[static_cast<unsigned char>(c)];
+}
+
+std::string codificarIUPAC(const std::string& secuencia) {
+    std::string codigos;
+    codificarIUPAC(secuencia, codigos);
+    return codigos;
+}
+
+void codificarIUPAC(const std::string& secuencia, std::string& codigos) {
+    codigos.resize(secuencia.size());
+    for (size_t i = 0; i < secuencia.size(); ++i) {
+        codigos[i] = static_cast<char>(TABLA_IUPAC.codigo[static_cast<unsigned char>(secuencia[i])]);
+    }
+}
+
+void codificarIUPAC(const SecuenciaDNA& secuencia, std::string& codigos) {
+    std::size_t n = secuencia.longitud();
+    codigos.resize(n);
+    for (std::size_t k = 0; k < secuencia.palabras(); ++k) {
+        std::uint64_t w = secuencia.palabra(k);
+        std::size_t fin = std::min(n, k * 32 + 32);
+        for (std::size_t i = k * 32; i < fin; ++i) {
+            // Base de 2 bits b -> código IUPAC 1 << b
+            codigos[i] = static_cast<char>(1 << (w & 3));
+            w >>= 2;
+        }
+    }
+    for (const auto& excepcion : secuencia.excepciones()) {
+        codigos[excepcion.first] = static_cast<char>(codigoIUPAC(excepcion.second));
+    }
+}
+
+std::vector<int> construirPerfilConsulta(const std::string& codigosB, const TablaSustitucionDNA& tabla) {
+    std::vector<int> perfil;
+    construirPerfilConsulta(codigosB, tabla, perfil);
+    return perfil;
+}
+
+void construirPerfilConsulta(const std::string& codigosB, const TablaSustitucionDNA& tabla,
+                             std::vector<int>& perfil) {
+    size_t n = codigosB.size();
+    perfil.resize(TAM_ALFABETO_IUPAC * n);
+    for (int c = 0; c < TAM_ALFABETO_IUPAC; ++c) {
+        const int* fila_tabla = tabla.fila(c);
+        int* fila = perfil.data() + c * n;
+        for (size_t j = 0; j < n; ++j) {
+            fila[j] = fila_tabla[static_cast<unsigned char>(codigosB[j])];
+        }
     }
-    
-    return config.parametros.sustitucion;
 }
 
 int obtenerPenalidadGapDNA(const ConfiguracionPuntuacionDNA& config) {
     return config.parametros.gap;
 }
 
+EsquemaFijoDNA detectarEsquemaFijo(const ConfiguracionPuntuacionDNA& config) {
+    if (config.iupac || config.gapAfin()) {
+        return ESQUEMA_GENERICO;
+    }
+    const EsquemaPuntuacionDNA& p = config.parametros;
+    if (p.coincidencia == 2 && p.sustitucion == -1 && p.gap == -2) {
+        return ESQUEMA_2_M1_M2;
+    }
+    if (p.coincidencia == 1 && p.sustitucion == -1 && p.gap == -2) {
+        return ESQUEMA_1_M1_M2;
+    }
+    if (p.coincidencia == 1 && p.sustitucion == -1 && p.gap == -1) {
+        return ESQUEMA_1_M1_M1;
+    }
+    if (p.coincidencia == 0 && p.sustitucion == -1 && p.gap == -1) {
+        return ESQUEMA_0_M1_M1;
+    }
+    return ESQUEMA_GENERICO;
+}
+
+const char* nombreEsquemaFijo(EsquemaFijoDNA esquema) {
+    switch (esquema) {
+        case ESQUEMA_2_M1_M2: return "2/-1/-2";
+        case ESQUEMA_1_M1_M2: return "1/-1/-2";
+        case ESQUEMA_1_M1_M1: return "1/-1/-1";
+        case ESQUEMA_0_M1_M1: return "0/-1/-1";
+        default: return "generico";
+    }
+}
@@ -0,0 +1,136 @@
+#include "secuencia_dna.h"
+#include <algorithm>
+#include <cctype>
+
+static const char SIMBOLOS_BASE[4] = {'A', 'C', 'G', 'T'};
+static const unsigned char CODIGO_EXCEPCION = 4;
+static const std::uint64_t BITS_PARES = 0x5555555555555555ULL;
+
+/**
+ * @brief Tabla byte -> código de 2 bits (CODIGO_EXCEPCION si no es ACGT).
+ */
+struct TablaCodigosDNA {
+    unsigned char codigo[256];
+
+    TablaCodigosDNA() {
+        for (int c = 0; c < 256; ++c) {
+            codigo[c] = CODIGO_EXCEPCION;
+        }
+        for (int k = 0; k < 4; ++k) {
+            codigo[static_cast<unsigned char>(SIMBOLOS_BASE[k])] = k;
+            codigo[std::tolower(static_cast<unsigned char>(SIMBOLOS_BASE[k]))] = k;
+        }
+    }
+};
+
+static const TablaCodigosDNA TABLA_CODIGOS;
+
+SecuenciaDNA::SecuenciaDNA(const std::string& secuencia) : longitud_(0) {
+    anadir(secuencia);
+}
+
+SecuenciaDNA::SecuenciaDNA(const std::uint64_t* palabras, std::size_t longitud)
+    : palabras_(palabras, palabras + (longitud + 31) / 32),
+      mascara_((longitud + 63) / 64, 0),
+      longitud_(longitud) {}
+
+void SecuenciaDNA::reservar(std::size_t bases) {
+    palabras_.reserve((bases + 31) / 32);
+    mascara_.reserve((bases + 63) / 64);
+}
+
+void SecuenciaDNA::anadir(const char* datos, std::size_t longitud) {
+    std::size_t total = longitud_ + longitud;
+    palabras_.resize((total + 31) / 32, 0);
+    mascara_.resize((total + 63) / 64, 0);
+
+    for (std::size_t k = 0; k < longitud; ++k) {
+        unsigned char c = static_cast<unsigned char>(datos[k]);
+        std::size_t i = longitud_ + k;
+        unsigned char codigo = TABLA_CODIGOS.codigo[c];
+        if (codigo != CODIGO_EXCEPCION) {
+            palabras_[i >> 5] |= static_cast<std::uint64_t>(codigo) << ((i & 31) * 2);
+        } else {
+            mascara_[i >> 6] |= std::uint64_t(1) << (i & 63);
+            excepciones_.push_back(std::make_pair(i, static_cast<char>(std::toupper(c))));
+        }
+    }
+    longitud_ = total;
+}
+
+void SecuenciaDNA::marcarExcepciones(std::size_t inicio, std::size_t longitud, char simbolo) {
+    char mayuscula = static_cast<char>(std::toupper(static_cast<unsigned char>(simbolo)));
+    for (std::size_t i = inicio; i < inicio + longitud; ++i) {
+        mascara_[i >> 6] |= std::uint64_t(1) << (i & 63);
+        excepciones_.push_back(std::make_pair(i, mayuscula));
+    }
+}
+
+char SecuenciaDNA::base(std::size_t i) const {
+    if (esExcepcion(i)) {
+        auto it = std::lower_bound(excepciones_.begin(), excepciones_.end(),
+                                   std::make_pair(i, static_cast<char>(0)));
+        return it->second;
+    }
+    return SIMBOLOS_BASE[(palabras_[i >> 5] >> ((i & 31) * 2)) & 3];
+}
+
+std::uint64_t SecuenciaDNA::palabraMascara(std::size_t k) const {
+    // 32 bits de máscara -> bits pares (intercalado de Morton)
+    std::uint64_t x = (mascara_[k >> 1] >> ((k & 1) * 32)) & 0xFFFFFFFFULL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & BITS_PARES;
+    return x;
+}
+
+std::string SecuenciaDNA::desempaquetar() const {
+    std::string secuencia(longitud_, 'A');
+    for (std::size_t k = 0; k < palabras_.size(); ++k) {
+        std::uint64_t w = palabras_[k];
+        std::size_t inicio = k * 32;
+        std::size_t fin = std::min(longitud_, inicio + 32);
+        for (std::size_t i = inicio; i < fin; ++i) {
+            secuencia[i] = SIMBOLOS_BASE[w & 3];
+            w >>= 2;
+        }
+    }
+    for (const auto& excepcion : excepciones_) {
+        secuencia[excepcion.first] = excepcion.second;
+    }
+    return secuencia;
+}
+
+std::size_t SecuenciaDNA::bytes() const {
+    return palabras_.size() * sizeof(std::uint64_t)
+         + mascara_.size() * sizeof(std::uint64_t)
+         + excepciones_.size() * sizeof(excepciones_[0]);
+}
+
+std::size_t contarCoincidenciasPosicionales(const SecuenciaDNA& a, const SecuenciaDNA& b) {
+    std::size_t n = std::min(a.longitud(), b.longitud());
+    std::size_t total = 0;
+
+    for (std::size_t k = 0; k * 32 < n; ++k) {
+        // Bit 2r a 1 si las bases r de ambas palabras tienen el mismo código
+        std::uint64_t x = a.palabra(k) ^ b.palabra(k);
+        std::uint64_t iguales = ~(x | (x >> 1)) & BITS_PARES;
+
+        std::size_t resto = n - k * 32;
+        std::uint64_t validas = (resto >= 32) ? BITS_PARES
+                              : (BITS_PARES & ((std::uint64_t(1) << (resto * 2)) - 1));
+        std::uint64_t excepciones = (a.palabraMascara(k) | b.palabraMascara(k)) & validas;
+
+        total += __builtin_popcountll(iguales & validas & ~excepciones);
+        // Código 0 no distingue A de una excepción: se comparan los símbolos
+        while (excepciones != 0) {
+            int bit = __builtin_ctzll(excepciones);
+            std::size_t i = k * 32 + bit / 2;
+            total += (a.base(i) == b.base(i));
+            excepciones &= excepciones - 1;
+        }
+    }
+    return total;
+}
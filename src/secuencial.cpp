@@ -1,9 +1,246 @@
 #include "secuencial.h"
 #include "puntuacion.h"
+#include "matriz_dp.h"
+#include "matriz_direcciones.h"
+#include "traceback.h"
+#include "poda.h"
 #include <vector>
 #include <algorithm>
 #include <chrono>
 
+/**
+ * @brief Kernel de una fila de la DP: actual[1..n] a partir de anterior[0..n]
+ *        y actual[0]. a es el código de A[i-1].
+ */
+typedef void (*KernelFila)(const int* anterior, int* actual, const int* perfil,
+                           unsigned char a, const char* codB, int n, int penalidadGap);
+
+/**
+ * @brief Fila con cualquier esquema: sustitución leída del perfil de consulta.
+ */
+static void llenarFilaPerfil(const int* anterior, int* actual, const int* perfil,
+                             unsigned char a, const char*, int n, int penalidadGap) {
+    const int* perfil_fila = perfil + static_cast<size_t>(a) * n;
+    for (int j = 1; j <= n; ++j) {
+        int coincidencia = anterior[j-1] + perfil_fila[j-1];
+        int eliminacion = anterior[j] + penalidadGap;
+        int insercion = actual[j-1] + penalidadGap;
+        
+        actual[j] = std::max({coincidencia, eliminacion, insercion});
+    }
+}
+
+/**
+ * @brief Fila con un esquema fijado en compilación (sin modo iupac).
+ *
+ * Las tres puntuaciones son constantes y la sustitución sale de comparar
+ * códigos (selección sin saltos), así que no hace falta perfil de consulta.
+ * El código 0 de A se sustituye por uno imposible para que no coincida.
+ */
+template <int COINCIDENCIA, int SUSTITUCION, int GAP>
+static void llenarFilaFija(const int* anterior, int* actual, const int*,
+                           unsigned char a, const char* codB, int n, int) {
+    char codigo = (a != 0) ? static_cast<char>(a) : static_cast<char>(TAM_ALFABETO_IUPAC);
+    for (int j = 1; j <= n; ++j) {
+        int iguales = (codB[j-1] == codigo);
+        int coincidencia = anterior[j-1] + SUSTITUCION + (COINCIDENCIA - SUSTITUCION) * iguales;
+        int eliminacion = anterior[j] + GAP;
+        int insercion = actual[j-1] + GAP;
+        
+        actual[j] = std::max({coincidencia, eliminacion, insercion});
+    }
+}
+
+/**
+ * @brief Elige el kernel de fila: la especialización del esquema si existe,
+ *        si no el genérico con perfil.
+ */
+static KernelFila seleccionarKernelFila(EsquemaFijoDNA esquema) {
+    switch (esquema) {
+        case ESQUEMA_2_M1_M2: return llenarFilaFija<2, -1, -2>;
+        case ESQUEMA_1_M1_M2: return llenarFilaFija<1, -1, -2>;
+        case ESQUEMA_1_M1_M1: return llenarFilaFija<1, -1, -1>;
+        case ESQUEMA_0_M1_M1: return llenarFilaFija<0, -1, -1>;
+        default: return llenarFilaPerfil;
+    }
+}
+
+/**
+ * @brief AlgNW con matriz de direcciones de 2 bits y dos filas rodantes.
+ *
+ * La fase 2 guarda el predecesor elegido en cada celda; la fase 3 solo sigue
+ * punteros. Produce el mismo alineamiento que el traceback por recálculo.
+ */
+static ResultadoAlineamiento AlgNWDirecciones(const std::string& secA, const std::string& secB,
+                                              const ConfiguracionAlineamiento& config,
+                                              EspacioTrabajo& espacio) {
+    int m = secA.length();
+    int n = secB.length();
+    
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    MatrizDirecciones& D = espacio.direcciones(m + 1, n + 1);
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    // Perfil de consulta: una carga por celda, sin comparar símbolos
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    const std::string& codA = espacio.codA;
+    const std::vector<int>& perfil = espacio.perfil;
+    std::vector<int>& anterior = espacio.anterior;
+    std::vector<int>& actual = espacio.actual;
+    anterior.resize(n + 1);
+    actual.resize(n + 1);
+    for (int j = 0; j <= n; ++j) {
+        anterior[j] = j * penalidadGap;
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    for (int i = 1; i <= m; ++i) {
+        actual[0] = i * penalidadGap;
+        unsigned char* bytes = D.byte(i, 0);
+        unsigned int acumulado = 0;
+        const int* perfil_fila = perfil.data() + static_cast<size_t>(codA[i-1]) * n;
+        for (int j = 1; j <= n; ++j) {
+            int coincidencia = anterior[j-1] + perfil_fila[j-1];
+            int eliminacion = anterior[j] + penalidadGap;
+            int insercion = actual[j-1] + penalidadGap;
+            
+            actual[j] = std::max({coincidencia, eliminacion, insercion});
+            // Cuatro direcciones por byte: se escribe al completar cada byte
+            acumulado |= elegirDireccion(coincidencia, eliminacion, insercion) << ((j & 3) * 2);
+            if ((j & 3) == 3 || j == n) {
+                bytes[j >> 2] = static_cast<unsigned char>(acumulado);
+                acumulado = 0;
+            }
+        }
+        anterior.swap(actual);
+    }
+    int puntuacion = anterior[n];
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackDirecciones(D, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    return ResultadoAlineamiento(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief AlgNW con poda X-drop/Z-drop (config.xdrop > 0).
+ *
+ * La fila i se calcula desde la primera celda viva de la fila i - 1 y, pasada
+ * la última, solo mientras la inserción mantenga viva la celda. Se guarda
+ * únicamente el tramo entre la primera y la última celda viva de cada fila;
+ * si una fila queda sin celdas vivas el llenado se detiene.
+ */
+static ResultadoAlineamiento AlgNWPoda(const std::string& secA, const std::string& secB,
+                                       const ConfiguracionAlineamiento& config) {
+    int m = secA.length();
+    int n = secB.length();
+    
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    TablaSustitucionDNA tabla(config.puntuacion);
+    std::string codA = codificarIUPAC(secA);
+    std::string codB = codificarIUPAC(secB);
+    MatrizPodada F(DISPOSICION_FILAS);
+    CriterioPoda criterio(config, penalidadGap);
+    std::vector<int> tramo(n + 1);
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+    
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    // Fila 0: decrece con j, así que basta cortar en la primera podada
+    int ultima = 0;
+    tramo[0] = 0;
+    while (ultima < n && !criterio.podar((ultima + 1) * penalidadGap, ultima + 1)) {
+        ++ultima;
+        tramo[ultima] = ultima * penalidadGap;
+    }
+    std::copy(tramo.begin(), tramo.begin() + ultima + 1, F.anadirLinea(0, ultima));
+    
+    std::size_t calculadas = 0;
+    int mejor_i = 0, mejor_j = 0;
+    for (int i = 1; i <= m; ++i) {
+        int primera_previa = F.primera(i-1);
+        int ultima_previa = F.ultima(i-1);
+        const int* previa = F.linea(i-1);
+        auto arriba = [&](int j) {
+            return (j >= primera_previa && j <= ultima_previa) ? previa[j - primera_previa] : PODA_MENOS_INFINITO;
+        };
+        int izquierda = PODA_MENOS_INFINITO;
+        int primera_viva = -1, ultima_viva = -1;
+        int mejor_fila = PODA_MENOS_INFINITO, j_mejor_fila = 0;
+        for (int j = primera_previa; j <= n; ++j) {
+            if (j > ultima_previa + 1 && izquierda == PODA_MENOS_INFINITO) {
+                break;
+            }
+            int valor;
+            if (j == 0) {
+                valor = arriba(0) + penalidadGap;
+            } else {
+                int coincidencia = arriba(j-1) + tabla(codA[i-1], codB[j-1]);
+                int eliminacion = arriba(j) + penalidadGap;
+                int insercion = izquierda + penalidadGap;
+                valor = std::max({coincidencia, eliminacion, insercion});
+                ++calculadas;
+            }
+            if (criterio.podar(valor, j - i)) {
+                valor = PODA_MENOS_INFINITO;
+            } else {
+                if (primera_viva < 0) primera_viva = j;
+                ultima_viva = j;
+                if (valor > mejor_fila) {
+                    mejor_fila = valor;
+                    j_mejor_fila = j;
+                }
+            }
+            tramo[j] = valor;
+            izquierda = valor;
+        }
+        if (primera_viva < 0) {
+            F.anadirLineaVacia();
+            break;
+        }
+        std::copy(tramo.begin() + primera_viva, tramo.begin() + ultima_viva + 1,
+                  F.anadirLinea(primera_viva, ultima_viva));
+        if (mejor_fila > criterio.mejor) {
+            criterio.mejor = mejor_fila;
+            criterio.diag_mejor = j_mejor_fila - i;
+            mejor_i = i;
+            mejor_j = j_mejor_fila;
+        }
+    }
+    // Si (m, n) no sobrevivió, el resultado es el de la mejor celda vista
+    bool truncado = F.valor(m, n) == PODA_MENOS_INFINITO;
+    int fin_i = truncado ? mejor_i : m;
+    int fin_j = truncado ? mejor_j : n;
+    int puntuacion = truncado ? criterio.mejor : F.valor(m, n);
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+    
+    auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackPodado(F, fin_i, fin_j, codA, codB, tabla, penalidadGap, secA, secB, config,
+                    alineadaA, alineadaB, cigar);
+    auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
+    
+    ResultadoAlineamiento resultado(alineadaA, alineadaB, puntuacion, tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+    resultado.truncado = truncado;
+    resultado.celdas_omitidas = static_cast<std::size_t>(m) * n - calculadas;
+    return resultado;
+}
+
 /**
  * @brief Ejecuta Needleman–Wunsch con recálculo del traceback (optimizado en memoria).
  *
@@ -17,21 +254,45 @@
  */
 ResultadoAlineamiento AlgNW(const std::string& secA, const std::string& secB, 
                             const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return AlgNW(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento AlgNW(const std::string& secA, const std::string& secB,
+                            const ConfiguracionAlineamiento& config, EspacioTrabajo& espacio) {
+    if (config.xdrop > 0) {
+        return AlgNWPoda(secA, secB, config);
+    }
+    if (config.traceback_direcciones) {
+        return AlgNWDirecciones(secA, secB, config, espacio);
+    }
     int m = secA.length();
     int n = secB.length();
     
     auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
-    std::vector<std::vector<int>> F(m + 1, std::vector<int>(n + 1, 0));
+    // Sin llenar(0): la inicialización y el llenado escriben todas las celdas
+    MatrizDP& F = espacio.matriz(m + 1, n + 1);
 
     int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    const std::string& codA = espacio.codA;
+    const std::string& codB = espacio.codB;
+    // Los esquemas especializados no usan perfil de consulta
+    EsquemaFijoDNA esquema = detectarEsquemaFijo(config.puntuacion);
+    KernelFila llenarFila = seleccionarKernelFila(esquema);
+    std::vector<int>& perfil = espacio.perfil;
+    if (esquema == ESQUEMA_GENERICO) {
+        construirPerfilConsulta(codB, TablaSustitucionDNA(config.puntuacion), perfil);
+    }
 
     // Inicialización
-    F[0][0] = 0;
+    F(0, 0) = 0;
     for (int i = 1; i <= m; ++i) {
-        F[i][0] = F[i-1][0] + penalidadGap;
+        F(i, 0) = F(i-1, 0) + penalidadGap;
     }
     for (int j = 1; j <= n; ++j) {
-        F[0][j] = F[0][j-1] + penalidadGap;
+        F(0, j) = F(0, j-1) + penalidadGap;
     }
     auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
     double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
@@ -39,54 +300,89 @@ ResultadoAlineamiento AlgNW(const std::string& secA, const std::string& secB,
     // Llenar la matriz
     auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
     for (int i = 1; i <= m; ++i) {
-        for (int j = 1; j <= n; ++j) {
-            int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-            int eliminacion = F[i-1][j] + penalidadGap;
-            int insercion = F[i][j-1] + penalidadGap;
-            
-            F[i][j] = std::max({coincidencia, eliminacion, insercion});
-        }
+        llenarFila(F.fila(i-1), F.fila(i), perfil.data(), codA[i-1], codB.data(), n, penalidadGap);
     }
     auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
     double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
     
     auto t_inicio_fase3 = std::chrono::high_resolution_clock::now();
-    std::string alineadaA = "";
-    std::string alineadaB = "";
-    int i = m, j = n;
-    
-    while (i > 0 || j > 0) {
-        if (i > 0 && j > 0) {
-            int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-            int eliminacion = (i > 0) ? F[i-1][j] + penalidadGap : -999999;
-            int insercion = (j > 0) ? F[i][j-1] + penalidadGap : -999999;
-            
-            if (F[i][j] == coincidencia) {
-                alineadaA = secA[i-1] + alineadaA;
-                alineadaB = secB[j-1] + alineadaB;
-                i--; j--;
-            } else if (F[i][j] == eliminacion) {
-                alineadaA = secA[i-1] + alineadaA;
-                alineadaB = "-" + alineadaB;
-                i--;
-            } else if (F[i][j] == insercion) {
-                alineadaA = "-" + alineadaA;
-                alineadaB = secB[j-1] + alineadaB;
-                j--;
-            }
-        } else if (i > 0) {
-            alineadaA = secA[i-1] + alineadaA;
-            alineadaB = "-" + alineadaB;
-            i--;
-        } else {
-            alineadaA = "-" + alineadaA;
-            alineadaB = secB[j-1] + alineadaB;
-            j--;
-        }
-    }
+    std::string alineadaA;
+    std::string alineadaB;
+    std::string cigar;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, espacio.pasos);
 
     auto t_fin_fase3 = std::chrono::high_resolution_clock::now();
     double tiempo_fase3_ms = std::chrono::duration<double, std::milli>(t_fin_fase3 - t_inicio_fase3).count();
 
-    return ResultadoAlineamiento(alineadaA, alineadaB, F[m][n], tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms);
-}
\ No newline at end of file
+    return ResultadoAlineamiento(alineadaA, alineadaB, F(m, n), tiempo_fase2_ms, tiempo_fase3_ms, tiempo_fase1_ms, cigar);
+}
+
+/**
+ * @brief Puntuación NW de dos secuencias ya codificadas, con dos filas rodantes.
+ *
+ * perfil es el perfil de consulta de codB (solo se usa con ESQUEMA_GENERICO);
+ * las filas salen de espacio.anterior y espacio.actual.
+ *
+ * @return Puntuación NW óptima.
+ */
+int puntuacionNWCodificada(const std::string& codA, const std::string& codB,
+                           const std::vector<int>& perfil,
+                           const ConfiguracionAlineamiento& config,
+                           EspacioTrabajo& espacio) {
+    int m = codA.length();
+    int n = codB.length();
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    KernelFila llenarFila = seleccionarKernelFila(detectarEsquemaFijo(config.puntuacion));
+    std::vector<int>& anterior = espacio.anterior;
+    std::vector<int>& actual = espacio.actual;
+    anterior.resize(n + 1);
+    actual.resize(n + 1);
+
+    anterior[0] = 0;
+    for (int j = 1; j <= n; ++j) {
+        anterior[j] = anterior[j-1] + penalidadGap;
+    }
+    for (int i = 1; i <= m; ++i) {
+        actual[0] = anterior[0] + penalidadGap;
+        llenarFila(anterior.data(), actual.data(), perfil.data(), codA[i-1], codB.data(), n, penalidadGap);
+        anterior.swap(actual);
+    }
+    return anterior[n];
+}
+
+/**
+ * @brief Calcula la puntuación de Needleman–Wunsch con dos filas rodantes.
+ *
+ * @param secA Secuencia A (DNA)
+ * @param secB Secuencia B (DNA)
+ * @param config Configuración de alineamiento
+ * @return ResultadoAlineamiento con puntuación y tiempos (sin alineamiento)
+ */
+ResultadoAlineamiento puntuacionNW(const std::string& secA, const std::string& secB,
+                                   const ConfiguracionAlineamiento& config) {
+    EspacioTrabajo espacio;
+    return puntuacionNW(secA, secB, config, espacio);
+}
+
+ResultadoAlineamiento puntuacionNW(const std::string& secA, const std::string& secB,
+                                   const ConfiguracionAlineamiento& config,
+                                   EspacioTrabajo& espacio) {
+    auto t_inicio_fase1 = std::chrono::high_resolution_clock::now();
+    codificarIUPAC(secA, espacio.codA);
+    codificarIUPAC(secB, espacio.codB);
+    if (detectarEsquemaFijo(config.puntuacion) == ESQUEMA_GENERICO) {
+        construirPerfilConsulta(espacio.codB, TablaSustitucionDNA(config.puntuacion), espacio.perfil);
+    }
+    auto t_fin_fase1 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase1_ms = std::chrono::duration<double, std::milli>(t_fin_fase1 - t_inicio_fase1).count();
+
+    // Fila 0 y llenado fila a fila, reutilizando los dos buffers
+    auto t_inicio_fase2 = std::chrono::high_resolution_clock::now();
+    int puntuacion = puntuacionNWCodificada(espacio.codA, espacio.codB, espacio.perfil, config, espacio);
+    auto t_fin_fase2 = std::chrono::high_resolution_clock::now();
+    double tiempo_fase2_ms = std::chrono::duration<double, std::milli>(t_fin_fase2 - t_inicio_fase2).count();
+
+    ResultadoAlineamiento resultado("", "", puntuacion, tiempo_fase2_ms, 0.0, tiempo_fase1_ms);
+    resultado.solo_puntuacion = true;
+    return resultado;
+}
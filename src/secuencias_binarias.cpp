@@ -0,0 +1,262 @@
+#include "secuencias_binarias.h"
+#include "fasta_mapeado.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+static const char SIMBOLOS_BASE[4] = {'A', 'C', 'G', 'T'};
+
+/** @brief Tabla byte -> sus 4 bases (2 bits cada una, la primera en los bits bajos). */
+struct TablaDecodificacionDNA {
+    char bases[256][4];
+
+    TablaDecodificacionDNA() {
+        for (int b = 0; b < 256; ++b) {
+            for (int k = 0; k < 4; ++k) {
+                bases[b][k] = SIMBOLOS_BASE[(b >> (2 * k)) & 3];
+            }
+        }
+    }
+};
+
+static const TablaDecodificacionDNA TABLA_DECODIFICACION;
+
+// Bytes de relleno para alinear cada bloque a 8
+static std::size_t relleno8(std::uint64_t bytes) {
+    return static_cast<std::size_t>((8 - bytes % 8) % 8);
+}
+
+EscritorSecuenciasBinarias::EscritorSecuenciasBinarias(const std::string& nombreArchivo)
+    : archivo_(nombreArchivo, std::ios::binary), posicion_(0), cerrado_(false) {
+    if (!archivo_.is_open()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << "\n";
+        return;
+    }
+    // Cabecera provisional: registros e índice se completan en cerrar()
+    CabeceraSecuenciasBinarias cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    escribir(&cabecera, sizeof(cabecera));
+}
+
+EscritorSecuenciasBinarias::~EscritorSecuenciasBinarias() {
+    if (!cerrado_) {
+        cerrar();
+    }
+}
+
+void EscritorSecuenciasBinarias::escribir(const void* datos, std::size_t bytes) {
+    archivo_.write(static_cast<const char*>(datos), static_cast<std::streamsize>(bytes));
+    posicion_ += bytes;
+}
+
+bool EscritorSecuenciasBinarias::anadir(const std::string& cabecera, const SecuenciaDNA& secuencia) {
+    if (!archivo_.is_open() || cerrado_) {
+        return false;
+    }
+    EntradaIndiceBinario entrada;
+    entrada.longitud = secuencia.longitud();
+
+    entrada.palabras = posicion_;
+    for (std::size_t k = 0; k < secuencia.palabras(); ++k) {
+        std::uint64_t palabra = secuencia.palabra(k);
+        escribir(&palabra, sizeof(palabra));
+    }
+
+    // Excepciones consecutivas con el mismo símbolo -> un tramo
+    std::vector<TramoExcepcionBinario> tramos;
+    for (const auto& excepcion : secuencia.excepciones()) {
+        std::uint32_t simbolo = static_cast<unsigned char>(excepcion.second);
+        if (!tramos.empty()) {
+            TramoExcepcionBinario& ultimo = tramos.back();
+            if (ultimo.simbolo == simbolo && ultimo.inicio + ultimo.longitud == excepcion.first
+                && ultimo.longitud < UINT32_MAX) {
+                ++ultimo.longitud;
+                continue;
+            }
+        }
+        tramos.push_back({excepcion.first, 1, simbolo});
+    }
+    entrada.tramos = posicion_;
+    entrada.numero_tramos = tramos.size();
+    if (!tramos.empty()) {
+        escribir(tramos.data(), tramos.size() * sizeof(TramoExcepcionBinario));
+    }
+
+    entrada.cabecera = posicion_;
+    entrada.longitud_cabecera = cabecera.size();
+    escribir(cabecera.data(), cabecera.size());
+    static const char ceros[8] = {0};
+    escribir(ceros, relleno8(posicion_));
+
+    indice_.push_back(entrada);
+    return archivo_.good();
+}
+
+bool EscritorSecuenciasBinarias::cerrar() {
+    if (!archivo_.is_open() || cerrado_) {
+        return false;
+    }
+    cerrado_ = true;
+    CabeceraSecuenciasBinarias cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.magia, MAGIA_SECUENCIAS_BINARIAS, sizeof(cabecera.magia));
+    cabecera.version = VERSION_SECUENCIAS_BINARIAS;
+    cabecera.registros = indice_.size();
+    cabecera.indice = posicion_;
+    if (!indice_.empty()) {
+        escribir(indice_.data(), indice_.size() * sizeof(EntradaIndiceBinario));
+    }
+    archivo_.seekp(0);
+    archivo_.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    archivo_.close();
+    return !archivo_.fail();
+}
+
+ArchivoSecuenciasBinario::ArchivoSecuenciasBinario(const std::string& nombreArchivo)
+    : archivo_(nombreArchivo), indice_(nullptr), registros_(0), valido_(false) {
+    if (!archivo_.abierto()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << "\n";
+        return;
+    }
+    if (!validar()) {
+        std::cerr << "Error: " << nombreArchivo << " no es un archivo de secuencias binario valido\n";
+        registros_ = 0;
+    }
+}
+
+bool ArchivoSecuenciasBinario::validar() {
+    const char* d = archivo_.datos();
+    std::uint64_t n = archivo_.tamano();
+    if (n < sizeof(CabeceraSecuenciasBinarias)) {
+        return false;
+    }
+    // La proyección (o el buffer de la copia) está alineada al menos a 8 y
+    // todos los bloques del archivo también, así que se leen en su sitio
+    const CabeceraSecuenciasBinarias* cabecera = reinterpret_cast<const CabeceraSecuenciasBinarias*>(d);
+    if (std::memcmp(cabecera->magia, MAGIA_SECUENCIAS_BINARIAS, sizeof(cabecera->magia)) != 0
+        || cabecera->version != VERSION_SECUENCIAS_BINARIAS
+        || cabecera->indice % 8 != 0 || cabecera->indice > n
+        || cabecera->registros > (n - cabecera->indice) / sizeof(EntradaIndiceBinario)) {
+        return false;
+    }
+    indice_ = reinterpret_cast<const EntradaIndiceBinario*>(d + cabecera->indice);
+    registros_ = static_cast<std::size_t>(cabecera->registros);
+
+    // Cada registro dentro de la zona de datos (solo se lee el índice); los
+    // tramos de un registro se comprueban cuando se pide ese registro
+    std::uint64_t fin_datos = cabecera->indice;
+    for (std::size_t r = 0; r < registros_; ++r) {
+        const EntradaIndiceBinario& e = indice_[r];
+        std::uint64_t palabras = (e.longitud + 31) / 32;
+        bool dentro = e.palabras % 8 == 0 && e.palabras <= fin_datos
+                   && palabras <= (fin_datos - e.palabras) / 8
+                   && e.tramos % 8 == 0 && e.tramos <= fin_datos
+                   && e.numero_tramos <= (fin_datos - e.tramos) / sizeof(TramoExcepcionBinario)
+                   && e.cabecera <= fin_datos && e.longitud_cabecera <= fin_datos - e.cabecera;
+        if (!dentro) {
+            return false;
+        }
+    }
+    valido_ = true;
+    return true;
+}
+
+bool ArchivoSecuenciasBinario::tramosValidos(std::size_t r) const {
+    // Ordenados y sin solaparse, como los espera marcarExcepciones
+    const EntradaIndiceBinario& e = indice_[r];
+    const TramoExcepcionBinario* t = tramos(r);
+    std::uint64_t fin_anterior = 0;
+    for (std::uint64_t k = 0; k < e.numero_tramos; ++k) {
+        if (t[k].inicio < fin_anterior || t[k].inicio > e.longitud
+            || t[k].longitud > e.longitud - t[k].inicio) {
+            std::cerr << "Error: el registro " << r << " del archivo binario tiene tramos de excepciones"
+                      << " invalidos (se ignoran)\n";
+            return false;
+        }
+        fin_anterior = t[k].inicio + t[k].longitud;
+    }
+    return true;
+}
+
+const std::uint64_t* ArchivoSecuenciasBinario::palabras(std::size_t r) const {
+    return reinterpret_cast<const std::uint64_t*>(archivo_.datos() + indice_[r].palabras);
+}
+
+const TramoExcepcionBinario* ArchivoSecuenciasBinario::tramos(std::size_t r) const {
+    return reinterpret_cast<const TramoExcepcionBinario*>(archivo_.datos() + indice_[r].tramos);
+}
+
+std::string ArchivoSecuenciasBinario::cabecera(std::size_t r) const {
+    const char* inicio = archivo_.datos() + indice_[r].cabecera;
+    return std::string(inicio, inicio + indice_[r].longitud_cabecera);
+}
+
+SecuenciaDNA ArchivoSecuenciasBinario::secuencia(std::size_t r) const {
+    SecuenciaDNA resultado(palabras(r), longitud(r));
+    if (!tramosValidos(r)) {
+        return resultado;
+    }
+    const TramoExcepcionBinario* t = tramos(r);
+    for (std::uint64_t k = 0; k < indice_[r].numero_tramos; ++k) {
+        resultado.marcarExcepciones(t[k].inicio, t[k].longitud, static_cast<char>(t[k].simbolo));
+    }
+    return resultado;
+}
+
+std::string ArchivoSecuenciasBinario::texto(std::size_t r) const {
+    std::size_t n = longitud(r);
+    const std::uint64_t* w = palabras(r);
+    std::string resultado(n, 'A');
+    // 4 bases por byte; la última palabra, incompleta, base a base
+    std::size_t completas = n / 32;
+    char* destino = &resultado[0];
+    for (std::size_t k = 0; k < completas; ++k, destino += 32) {
+        std::uint64_t palabra = w[k];
+        for (int b = 0; b < 8; ++b, palabra >>= 8) {
+            std::memcpy(destino + 4 * b, TABLA_DECODIFICACION.bases[palabra & 0xFF], 4);
+        }
+    }
+    if (completas * 32 < n) {
+        std::uint64_t palabra = w[completas];
+        for (std::size_t j = completas * 32; j < n; ++j, palabra >>= 2) {
+            resultado[j] = SIMBOLOS_BASE[palabra & 3];
+        }
+    }
+    if (!tramosValidos(r)) {
+        return resultado;
+    }
+    const TramoExcepcionBinario* t = tramos(r);
+    for (std::uint64_t k = 0; k < indice_[r].numero_tramos; ++k) {
+        std::fill_n(resultado.begin() + t[k].inicio, t[k].longitud, static_cast<char>(t[k].simbolo));
+    }
+    return resultado;
+}
+
+bool esArchivoSecuenciasBinario(const std::string& nombreArchivo) {
+    std::ifstream archivo(nombreArchivo, std::ios::binary);
+    char magia[sizeof(MAGIA_SECUENCIAS_BINARIAS)];
+    return archivo.read(magia, sizeof(magia))
+        && std::memcmp(magia, MAGIA_SECUENCIAS_BINARIAS, sizeof(magia)) == 0;
+}
+
+long long convertirFastaABinario(const std::string& archivo_fasta, const std::string& archivo_binario) {
+    ArchivoFastaMapeado fasta(archivo_fasta);
+    if (!fasta.abierto()) {
+        return -1;
+    }
+    EscritorSecuenciasBinarias escritor(archivo_binario);
+    if (!escritor.abierto()) {
+        return -1;
+    }
+    for (std::size_t r = 0; r < fasta.registros(); ++r) {
+        if (!escritor.anadir(fasta.cabecera(r), fasta.empaquetar(r))) {
+            std::cerr << "Error: No se pudo escribir en " << archivo_binario << "\n";
+            return -1;
+        }
+    }
+    if (!escritor.cerrar()) {
+        std::cerr << "Error: No se pudo escribir en " << archivo_binario << "\n";
+        return -1;
+    }
+    return static_cast<long long>(fasta.registros());
+}
@@ -0,0 +1,278 @@
+#include "simd_estriado.h"
+#include "secuencial.h"
+#include "puntuacion.h"
+#include "matriz_dp.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NW_SIMD_X86 1
+#endif
+
+#ifdef NW_SIMD_X86
+
+// Vectores genéricos de GCC: el mismo kernel se compila para SSE4.1 o AVX2
+// según el atributo target de la función que lo instancia.
+typedef short v8hi  __attribute__((vector_size(16)));
+typedef int   v4si  __attribute__((vector_size(16)));
+typedef short v16hi __attribute__((vector_size(32)));
+typedef int   v8si  __attribute__((vector_size(32)));
+
+/**
+ * @brief Máscara de __builtin_shuffle que desplaza un carril hacia arriba.
+ *
+ * El carril l toma el carril l-1 y el carril 0 toma el primer elemento del
+ * segundo operando (índice L), que se usa como valor de relleno.
+ */
+template <typename V> struct MascaraDesplazamiento { static const V valor; };
+template <> const v8hi MascaraDesplazamiento<v8hi>::valor = {8, 0, 1, 2, 3, 4, 5, 6};
+template <> const v4si MascaraDesplazamiento<v4si>::valor = {4, 0, 1, 2};
+template <> const v16hi MascaraDesplazamiento<v16hi>::valor =
+    {16, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+template <> const v8si MascaraDesplazamiento<v8si>::valor = {8, 0, 1, 2, 3, 4, 5, 6};
+
+/** @brief true si algún carril de a es mayor que el de b. */
+template <typename V>
+static inline __attribute__((always_inline)) bool algunMayor(const V& a, const V& b) {
+    V comparacion = a > b;
+    uint64_t palabras[sizeof(V) / sizeof(uint64_t)];
+    std::memcpy(palabras, &comparacion, sizeof(V));
+    uint64_t acumulado = 0;
+    for (size_t q = 0; q < sizeof(V) / sizeof(uint64_t); ++q) {
+        acumulado |= palabras[q];
+    }
+    return acumulado != 0;
+}
+
+/**
+ * @brief Relleno "menos infinito" por tipo de celda.
+ *
+ * Lo bastante lejos del rango real para no ganar nunca un máximo y lo bastante
+ * lejos del mínimo representable para que sumarle un gap no desborde.
+ */
+template <typename T> struct MenosInfinito;
+template <> struct MenosInfinito<short> { static const short valor = -16384; };
+template <> struct MenosInfinito<int> { static const int valor = -(1 << 29); };
+
+/**
+ * @brief Kernel estriado de Farrar para gap lineal.
+ *
+ * Se expande (always_inline) dentro de cada función con atributo target, de
+ * modo que las operaciones vectoriales se emiten con ese conjunto.
+ *
+ * @param perfil Perfil de consulta: seg vectores por símbolo de B.
+ * @param indiceB Símbolo (índice en el perfil) de cada posición de B.
+ * @param h_cargar,h_guardar Dos columnas de seg vectores cada una.
+ * @return int Puntuación H[m][n].
+ */
+template <typename V, typename T>
+static inline __attribute__((always_inline)) int kernelEstriado(
+    const V* perfil, const unsigned char* indiceB, int m, int n, int seg,
+    int penalidadGap, V* h_cargar, V* h_guardar) {
+
+    const int L = sizeof(V) / sizeof(T);
+    const V& mascara = MascaraDesplazamiento<V>::valor;
+    V v_gap = V() + static_cast<T>(penalidadGap);
+    V v_inf = V() + MenosInfinito<T>::valor;
+
+    // Columna 0: H[i][0] = i * gap (posición p = fila p + 1)
+    for (int k = 0; k < seg; ++k) {
+        for (int l = 0; l < L; ++l) {
+            h_cargar[k][l] = static_cast<T>((l * seg + k + 1) * penalidadGap);
+        }
+    }
+
+    for (int j = 1; j <= n; ++j) {
+        const V* p = perfil + static_cast<size_t>(indiceB[j-1]) * seg;
+
+        // Diagonal del primer segmento: último segmento desplazado, con H[0][j-1]
+        V v_borde = V() + static_cast<T>((j - 1) * penalidadGap);
+        V vHdiag = __builtin_shuffle(h_cargar[seg-1], v_borde, mascara);
+        // F que entra desde la fila 0 solo afecta al carril 0
+        V vF = v_inf;
+        vF[0] = static_cast<T>(j * penalidadGap + penalidadGap);
+
+        for (int k = 0; k < seg; ++k) {
+            V vH = vHdiag + p[k];
+            V vE = h_cargar[k] + v_gap;
+            vH = vH > vE ? vH : vE;
+            vH = vH > vF ? vH : vF;
+            h_guardar[k] = vH;
+            vF = vH + v_gap;
+            vHdiag = h_cargar[k];
+        }
+
+        // Lazy-F: propagar el gap vertical entre carriles hasta que no mejore
+        vF = __builtin_shuffle(vF, v_inf, mascara);
+        int k = 0;
+        while (algunMayor(vF, h_guardar[k])) {
+            V vH = h_guardar[k];
+            h_guardar[k] = vH > vF ? vH : vF;
+            vF = vF + v_gap;
+            if (++k == seg) {
+                k = 0;
+                vF = __builtin_shuffle(vF, v_inf, mascara);
+            }
+        }
+
+        std::swap(h_cargar, h_guardar);
+    }
+
+    return h_cargar[(m - 1) % seg][(m - 1) / seg];
+}
+
+typedef int (*FuncionKernel)(const void*, const unsigned char*, int, int, int, int, void*, void*);
+
+#define DEFINIR_KERNEL(nombre, objetivo, V, T)                                          \
+    __attribute__((target(objetivo))) static int nombre(                                 \
+        const void* perfil, const unsigned char* indiceB, int m, int n, int seg,         \
+        int penalidadGap, void* h_cargar, void* h_guardar) {                             \
+        return kernelEstriado<V, T>(static_cast<const V*>(perfil), indiceB, m, n, seg,   \
+                                    penalidadGap, static_cast<V*>(h_cargar),             \
+                                    static_cast<V*>(h_guardar));                         \
+    }
+
+DEFINIR_KERNEL(kernelSSE41_16, "sse4.1", v8hi, short)
+DEFINIR_KERNEL(kernelSSE41_32, "sse4.1", v4si, int)
+DEFINIR_KERNEL(kernelAVX2_16, "avx2", v16hi, short)
+DEFINIR_KERNEL(kernelAVX2_32, "avx2", v8si, int)
+
+#undef DEFINIR_KERNEL
+
+/**
+ * @brief Construye el perfil de consulta estriado y ejecuta el kernel.
+ *
+ * @tparam T Tipo de celda (short o int).
+ * @param bytes_vector Tamaño del vector en bytes (16 o 32).
+ */
+template <typename T>
+static int puntuacionEstriada(const std::string& secA, const std::string& secB,
+                              const ConfiguracionPuntuacionDNA& puntuacion,
+                              int bytes_vector, FuncionKernel kernel,
+                              double& tiempo_preparacion_ms, double& tiempo_kernel_ms) {
+    auto t_inicio = std::chrono::high_resolution_clock::now();
+
+    int m = secA.length();
+    int n = secB.length();
+    int penalidadGap = obtenerPenalidadGapDNA(puntuacion);
+    const int L = bytes_vector / sizeof(T);
+    const int seg = (m + L - 1) / L;
+
+    // Códigos IUPAC de B, comprimidos a índices 0..s-1
+    TablaSustitucionDNA tabla(puntuacion);
+    std::string codA = codificarIUPAC(secA);
+    int indice_simbolo[TAM_ALFABETO_IUPAC];
+    std::fill(indice_simbolo, indice_simbolo + TAM_ALFABETO_IUPAC, -1);
+    std::vector<unsigned char> simbolos;
+    std::vector<unsigned char> indiceB(n);
+    for (int j = 0; j < n; ++j) {
+        unsigned char c = codigoIUPAC(secB[j]);
+        if (indice_simbolo[c] < 0) {
+            indice_simbolo[c] = static_cast<int>(simbolos.size());
+            simbolos.push_back(c);
+        }
+        indiceB[j] = static_cast<unsigned char>(indice_simbolo[c]);
+    }
+
+    // Perfil: perfil[s][k][l] = puntuación(secA[l*seg + k], símbolo s); relleno = 0
+    size_t elementos_perfil = simbolos.size() * static_cast<size_t>(seg) * L;
+    size_t elementos_columna = static_cast<size_t>(seg) * L;
+    T* perfil = static_cast<T*>(reservarAlineado(MatrizDP::ALINEACION_BYTES,
+                                                 (elementos_perfil + 2 * elementos_columna) * sizeof(T)));
+    if (perfil == nullptr) {
+        throw std::bad_alloc();
+    }
+    T* h_cargar = perfil + elementos_perfil;
+    T* h_guardar = h_cargar + elementos_columna;
+
+    for (size_t s = 0; s < simbolos.size(); ++s) {
+        T* fila = perfil + s * elementos_columna;
+        for (int k = 0; k < seg; ++k) {
+            for (int l = 0; l < L; ++l) {
+                int i = l * seg + k;
+                fila[k * L + l] = (i < m)
+                    ? static_cast<T>(tabla(codA[i], simbolos[s]))
+                    : static_cast<T>(0);
+            }
+        }
+    }
+    auto t_fin_preparacion = std::chrono::high_resolution_clock::now();
+
+    int resultado = kernel(perfil, indiceB.data(), m, n, seg, penalidadGap, h_cargar, h_guardar);
+
+    auto t_fin_kernel = std::chrono::high_resolution_clock::now();
+    liberarAlineado(perfil);
+
+    tiempo_preparacion_ms = std::chrono::duration<double, std::milli>(t_fin_preparacion - t_inicio).count();
+    tiempo_kernel_ms = std::chrono::duration<double, std::milli>(t_fin_kernel - t_fin_preparacion).count();
+    return resultado;
+}
+
+#endif // NW_SIMD_X86
+
+ConjuntoSimd detectarConjuntoSimd() {
+#ifdef NW_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return SIMD_SSE41;
+#endif
+    return SIMD_ESCALAR;
+}
+
+const char* nombreConjuntoSimd(ConjuntoSimd conjunto) {
+    switch (conjunto) {
+        case SIMD_AVX2: return "avx2";
+        case SIMD_SSE41: return "sse4.1";
+        default: return "escalar";
+    }
+}
+
+ResultadoAlineamiento puntuacionNWSimd(const std::string& secA, const std::string& secB,
+                                       const ConfiguracionAlineamiento& config) {
+    return puntuacionNWSimd(secA, secB, config, detectarConjuntoSimd());
+}
+
+ResultadoAlineamiento puntuacionNWSimd(const std::string& secA, const std::string& secB,
+                                       const ConfiguracionAlineamiento& config,
+                                       ConjuntoSimd conjunto) {
+    conjunto = std::min(conjunto, detectarConjuntoSimd());
+    int m = secA.length();
+    int n = secB.length();
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+
+    // El lazy-F solo termina si el gap penaliza; matrices degeneradas van al escalar
+    if (conjunto == SIMD_ESCALAR || penalidadGap >= 0 || m == 0 || n == 0) {
+        return puntuacionNW(secA, secB, config);
+    }
+
+#ifdef NW_SIMD_X86
+    // Celdas de 16 bits si ninguna puntuación (incluido el relleno) puede salir de rango
+    const EsquemaPuntuacionDNA& p = config.puntuacion.parametros;
+    long long maximo_abs = std::max(std::abs(p.coincidencia), std::max(std::abs(p.sustitucion), std::abs(p.gap)));
+    bool cabe_16 = (static_cast<long long>(m) + n + 2 * 16 + 2) * maximo_abs < 16000;
+
+    int puntuacion;
+    double tiempo_fase1_ms = 0.0;
+    double tiempo_fase2_ms = 0.0;
+    if (conjunto == SIMD_AVX2) {
+        puntuacion = cabe_16
+            ? puntuacionEstriada<short>(secA, secB, config.puntuacion, 32, kernelAVX2_16, tiempo_fase1_ms, tiempo_fase2_ms)
+            : puntuacionEstriada<int>(secA, secB, config.puntuacion, 32, kernelAVX2_32, tiempo_fase1_ms, tiempo_fase2_ms);
+    } else {
+        puntuacion = cabe_16
+            ? puntuacionEstriada<short>(secA, secB, config.puntuacion, 16, kernelSSE41_16, tiempo_fase1_ms, tiempo_fase2_ms)
+            : puntuacionEstriada<int>(secA, secB, config.puntuacion, 16, kernelSSE41_32, tiempo_fase1_ms, tiempo_fase2_ms);
+    }
+
+    ResultadoAlineamiento resultado("", "", puntuacion, tiempo_fase2_ms, 0.0, tiempo_fase1_ms);
+    resultado.solo_puntuacion = true;
+    return resultado;
+#else
+    return puntuacionNW(secA, secB, config);
+#endif
+}
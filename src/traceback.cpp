@@ -0,0 +1,189 @@
+#include "traceback.h"
+#include "puntuacion.h"
+#include <cctype>
+
+static void anadirOperacion(std::string& cigar, std::size_t cuenta, char operacion) {
+    if (cuenta > 0) {
+        cigar += std::to_string(cuenta);
+        cigar += operacion;
+    }
+}
+
+/**
+ * @brief Convierte los pasos (en orden inverso) en secuencias con gaps o en CIGAR.
+ *
+ * Recorre el buffer de atrás hacia adelante, es decir, en el orden del
+ * alineamiento, de modo que no hace falta invertir nada.
+ */
+static void construirSalida(const std::string& pasos,
+                            const std::string& secA, const std::string& secB,
+                            bool compacto,
+                            std::string& alineadaA, std::string& alineadaB,
+                            std::string& cigar) {
+    std::size_t longitud = pasos.size();
+    std::size_t ia = 0, ib = 0;
+    alineadaA.clear();
+    alineadaB.clear();
+    cigar.clear();
+
+    if (!compacto) {
+        alineadaA.resize(longitud);
+        alineadaB.resize(longitud);
+        for (std::size_t k = 0; k < longitud; ++k) {
+            char paso = pasos[longitud - 1 - k];
+            alineadaA[k] = (paso == PASO_IZQUIERDA) ? '-' : secA[ia++];
+            alineadaB[k] = (paso == PASO_ARRIBA) ? '-' : secB[ib++];
+        }
+        return;
+    }
+
+    char operacion_actual = 0;
+    std::size_t cuenta = 0;
+    for (std::size_t k = 0; k < longitud; ++k) {
+        char paso = pasos[longitud - 1 - k];
+        char operacion;
+        if (paso == PASO_DIAGONAL) {
+            bool iguales = std::toupper(static_cast<unsigned char>(secA[ia]))
+                        == std::toupper(static_cast<unsigned char>(secB[ib]));
+            operacion = iguales ? '=' : 'X';
+            ++ia;
+            ++ib;
+        } else if (paso == PASO_ARRIBA) {
+            operacion = 'D';
+            ++ia;
+        } else {
+            operacion = 'I';
+            ++ib;
+        }
+        if (operacion != operacion_actual) {
+            anadirOperacion(cigar, cuenta, operacion_actual);
+            operacion_actual = operacion;
+            cuenta = 0;
+        }
+        ++cuenta;
+    }
+    anadirOperacion(cigar, cuenta, operacion_actual);
+}
+
+void construirSalidaTraceback(const std::string& pasos,
+                              const std::string& secA, const std::string& secB,
+                              const ConfiguracionAlineamiento& config,
+                              std::string& alineadaA, std::string& alineadaB,
+                              std::string& cigar) {
+    construirSalida(pasos, secA, secB, config.salida_cigar, alineadaA, alineadaB, cigar);
+}
+
+void tracebackMatrizDP(const MatrizDP& F,
+                       const std::string& secA, const std::string& secB,
+                       const ConfiguracionAlineamiento& config,
+                       std::string& alineadaA, std::string& alineadaB,
+                       std::string& cigar) {
+    std::string pasos;
+    tracebackMatrizDP(F, secA, secB, config, alineadaA, alineadaB, cigar, pasos);
+}
+
+void tracebackMatrizDP(const MatrizDP& F,
+                       const std::string& secA, const std::string& secB,
+                       const ConfiguracionAlineamiento& config,
+                       std::string& alineadaA, std::string& alineadaB,
+                       std::string& cigar, std::string& pasos) {
+    int i = F.filas() - 1;
+    int j = F.columnas() - 1;
+    int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
+    pasos.clear();
+    pasos.reserve(static_cast<std::size_t>(i) + j);
+
+    while (i > 0 && j > 0) {
+        int actual = F(i, j);
+        if (actual == F(i-1, j-1) + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion)) {
+            pasos.push_back(PASO_DIAGONAL);
+            --i; --j;
+        } else if (actual == F(i-1, j) + penalidadGap) {
+            pasos.push_back(PASO_ARRIBA);
+            --i;
+        } else {
+            pasos.push_back(PASO_IZQUIERDA);
+            --j;
+        }
+    }
+    // Fila 0 / columna 0: solo quedan gaps
+    pasos.append(i, PASO_ARRIBA);
+    pasos.append(j, PASO_IZQUIERDA);
+
+    construirSalida(pasos, secA, secB, config.salida_cigar, alineadaA, alineadaB, cigar);
+}
+
+void tracebackDirecciones(const MatrizDirecciones& direcciones,
+                          const std::string& secA, const std::string& secB,
+                          const ConfiguracionAlineamiento& config,
+                          std::string& alineadaA, std::string& alineadaB,
+                          std::string& cigar) {
+    std::string pasos;
+    tracebackDirecciones(direcciones, secA, secB, config, alineadaA, alineadaB, cigar, pasos);
+}
+
+void tracebackDirecciones(const MatrizDirecciones& direcciones,
+                          const std::string& secA, const std::string& secB,
+                          const ConfiguracionAlineamiento& config,
+                          std::string& alineadaA, std::string& alineadaB,
+                          std::string& cigar, std::string& pasos) {
+    int i = direcciones.filas() - 1;
+    int j = direcciones.columnas() - 1;
+    pasos.clear();
+    pasos.reserve(static_cast<std::size_t>(i) + j);
+
+    while (i > 0 && j > 0) {
+        Direccion direccion = direcciones.obtener(i, j);
+        if (direccion == DIR_DIAGONAL) {
+            pasos.push_back(PASO_DIAGONAL);
+            --i; --j;
+        } else if (direccion == DIR_ARRIBA) {
+            pasos.push_back(PASO_ARRIBA);
+            --i;
+        } else {
+            pasos.push_back(PASO_IZQUIERDA);
+            --j;
+        }
+    }
+    pasos.append(i, PASO_ARRIBA);
+    pasos.append(j, PASO_IZQUIERDA);
+
+    construirSalida(pasos, secA, secB, config.salida_cigar, alineadaA, alineadaB, cigar);
+}
+
+std::string cigarDesdeAlineamiento(const std::string& alineadaA, const std::string& alineadaB) {
+    std::string pasos(alineadaA.size(), PASO_DIAGONAL);
+    std::string soloA, soloB;
+    soloA.reserve(alineadaA.size());
+    soloB.reserve(alineadaB.size());
+    // construirSalida espera los pasos en orden inverso
+    for (std::size_t k = 0; k < alineadaA.size(); ++k) {
+        char a = alineadaA[k];
+        char b = alineadaB[k];
+        char& paso = pasos[alineadaA.size() - 1 - k];
+        if (a == '-') {
+            paso = PASO_IZQUIERDA;
+        } else if (b == '-') {
+            paso = PASO_ARRIBA;
+        }
+        if (a != '-') soloA.push_back(a);
+        if (b != '-') soloB.push_back(b);
+    }
+    std::string vaciaA, vaciaB, cigar;
+    construirSalida(pasos, soloA, soloB, true, vaciaA, vaciaB, cigar);
+    return cigar;
+}
+
+std::size_t longitudCIGAR(const std::string& cigar) {
+    std::size_t total = 0;
+    std::size_t cuenta = 0;
+    for (char c : cigar) {
+        if (c >= '0' && c <= '9') {
+            cuenta = cuenta * 10 + (c - '0');
+        } else {
+            total += cuenta;
+            cuenta = 0;
+        }
+    }
+    return total;
+}
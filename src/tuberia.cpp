@@ -0,0 +1,162 @@
+#include "tuberia.h"
+#include "lote.h"
+#include "utilidades.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <omp.h>
+
+// Soporte para eventos de Extrae (opcional)
+#ifdef HAVE_EXTRAE
+#include <extrae.h>
+#endif
+
+/** @brief Par leído, en tránsito entre el lector y los trabajadores. */
+struct ParLeido {
+    std::size_t indice;
+    std::string a;
+    std::string b;
+};
+
+static double milisegundos(std::chrono::high_resolution_clock::time_point desde,
+                           std::chrono::high_resolution_clock::time_point hasta) {
+    return std::chrono::duration<double, std::milli>(hasta - desde).count();
+}
+
+ResultadoTuberia alinearEnTuberia(const std::string& archivo_fasta,
+                                  const ConfiguracionAlineamiento& config,
+                                  const OpcionesTuberia& opciones,
+                                  const std::function<void(const ParAlineado&)>& escribir) {
+    typedef std::chrono::high_resolution_clock Reloj;
+    ResultadoTuberia tuberia;
+    LectorFasta lector(archivo_fasta);
+    if (!lector.abierto()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << archivo_fasta << "\n";
+        return tuberia;
+    }
+
+    int trabajadores = (opciones.trabajadores > 0) ? opciones.trabajadores
+                                                   : std::max(1, omp_get_max_threads() - 2);
+    ColaAcotada<ParLeido> pares(opciones.capacidad_cola);
+    ColaAcotada<ParAlineado> resultados(opciones.capacidad_cola);
+    std::vector<EstadisticasEtapa> por_trabajador(trabajadores);
+    std::atomic<int> activos(0);
+    bool threads_suficientes = true;
+    auto t_inicio = Reloj::now();
+
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 1);
+#endif
+    #pragma omp parallel num_threads(trabajadores + 2)
+    {
+        int id = omp_get_thread_num();
+        #pragma omp single
+        {
+            // Con menos threads de los pedidos (OMP_THREAD_LIMIT) se reparten los que haya
+            trabajadores = std::min(trabajadores, omp_get_num_threads() - 2);
+            threads_suficientes = (trabajadores >= 1);
+            activos = trabajadores;
+        }
+
+        if (!threads_suficientes) {
+            // Sin al menos un lector, un escritor y un trabajador no hay tubería
+        } else if (id == 0) {
+            // Lector: pares consecutivos (1-2, 3-4, ...)
+            EstadisticasEtapa& etapa = tuberia.lectura;
+            etapa.threads = 1;
+            ParLeido par;
+            par.indice = 0;
+            while (true) {
+                auto t_lectura = Reloj::now();
+                bool hay_par = lector.siguiente(par.a) && lector.siguiente(par.b);
+                auto t_leido = Reloj::now();
+                etapa.ocupado_ms += milisegundos(t_lectura, t_leido);
+                if (!hay_par) {
+                    break;
+                }
+                ++etapa.elementos;
+                etapa.volumen += par.a.size() + par.b.size();
+                std::size_t siguiente_indice = par.indice + 1;
+                pares.poner(std::move(par));
+                etapa.espera_ms += milisegundos(t_leido, Reloj::now());
+                par.indice = siguiente_indice;
+            }
+            pares.cerrar();
+        } else if (id == 1) {
+            // Escritor: en orden de llegada
+            EstadisticasEtapa& etapa = tuberia.escritura;
+            etapa.threads = 1;
+            ParAlineado alineado;
+            while (true) {
+                auto t_espera = Reloj::now();
+                bool hay_resultado = resultados.tomar(alineado);
+                auto t_escritura = Reloj::now();
+                etapa.espera_ms += milisegundos(t_espera, t_escritura);
+                if (!hay_resultado) {
+                    break;
+                }
+                escribir(alineado);
+                etapa.ocupado_ms += milisegundos(t_escritura, Reloj::now());
+                ++etapa.elementos;
+                ++etapa.volumen;
+            }
+        } else if (id - 2 < trabajadores) {
+            // Trabajador: buffers propios reutilizados en todos sus pares
+            EstadisticasEtapa& etapa = por_trabajador[id - 2];
+            EspacioTrabajo espacio;
+            ParLeido par;
+            while (true) {
+                auto t_espera = Reloj::now();
+                bool hay_par = pares.tomar(par);
+                auto t_alineamiento = Reloj::now();
+                etapa.espera_ms += milisegundos(t_espera, t_alineamiento);
+                if (!hay_par) {
+                    break;
+                }
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, static_cast<long long>(par.indice) + 1);
+#endif
+                ParAlineado alineado;
+                alineado.indice = par.indice;
+                alineado.longitud_a = par.a.size();
+                alineado.longitud_b = par.b.size();
+                alineado.thread = id;
+                alineado.trabajadores = trabajadores;
+                alineado.resultado = alinearPar(par.a, par.b, config, opciones.solo_puntuacion, espacio);
+#ifdef HAVE_EXTRAE
+                Extrae_event(4000, 0);
+#endif
+                auto t_alineado = Reloj::now();
+                etapa.ocupado_ms += milisegundos(t_alineamiento, t_alineado);
+                ++etapa.elementos;
+                etapa.volumen += alineado.longitud_a * alineado.longitud_b;
+                resultados.poner(std::move(alineado));
+                etapa.espera_ms += milisegundos(t_alineado, Reloj::now());
+            }
+            // El último trabajador en terminar cierra la cola del escritor
+            if (--activos == 0) {
+                resultados.cerrar();
+            }
+        }
+    }
+#ifdef HAVE_EXTRAE
+    Extrae_event(2000, 0);
+#endif
+    tuberia.tiempo_total_ms = milisegundos(t_inicio, Reloj::now());
+
+    if (!threads_suficientes) {
+        std::cerr << "Error: la tuberia necesita al menos 3 threads (lector, escritor y un trabajador)\n";
+        return tuberia;
+    }
+    tuberia.alineamiento.threads = trabajadores;
+    for (int t = 0; t < trabajadores; ++t) {
+        tuberia.alineamiento.elementos += por_trabajador[t].elementos;
+        tuberia.alineamiento.volumen += por_trabajador[t].volumen;
+        tuberia.alineamiento.ocupado_ms += por_trabajador[t].ocupado_ms;
+        tuberia.alineamiento.espera_ms += por_trabajador[t].espera_ms;
+    }
+    tuberia.correcto = true;
+    return tuberia;
+}
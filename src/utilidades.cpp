@@ -1,5 +1,8 @@
 #include "utilidades.h"
 #include "puntuacion.h"
+#include "matriz_dp.h"
+#include "fasta_mapeado.h"
+#include "secuencias_binarias.h"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
@@ -68,32 +71,34 @@ void compararResultados(const ResultadoAlineamiento& resultado1, const Resultado
     std::cout << "================================\n\n";
 }
 
-static std::vector<std::vector<int>> calcularMatrizPuntuacion(
+static MatrizDP calcularMatrizPuntuacion(
     const std::string& secA,
     const std::string& secB,
     const ConfiguracionAlineamiento& config) {
     
     int m = secA.length();
     int n = secB.length();
-    std::vector<std::vector<int>> F(m + 1, std::vector<int>(n + 1, 0));
+    MatrizDP F(m + 1, n + 1);
     int penalidadGap = obtenerPenalidadGapDNA(config.puntuacion);
     
     // Inicialización
-    F[0][0] = 0;
+    F(0, 0) = 0;
     for (int i = 1; i <= m; ++i) {
-        F[i][0] = F[i-1][0] + penalidadGap;
+        F(i, 0) = F(i-1, 0) + penalidadGap;
     }
     for (int j = 1; j <= n; ++j) {
-        F[0][j] = F[0][j-1] + penalidadGap;
+        F(0, j) = F(0, j-1) + penalidadGap;
     }
     
     // Llenar la matriz
     for (int i = 1; i <= m; ++i) {
+        const int* anterior = F.fila(i-1);
+        int* actual = F.fila(i);
         for (int j = 1; j <= n; ++j) {
-            int coincidencia = F[i-1][j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
-            int eliminacion = F[i-1][j] + penalidadGap;
-            int insercion = F[i][j-1] + penalidadGap;
-            F[i][j] = std::max({coincidencia, eliminacion, insercion});
+            int coincidencia = anterior[j-1] + obtenerPuntuacionDNA(secA[i-1], secB[j-1], config.puntuacion);
+            int eliminacion = anterior[j] + penalidadGap;
+            int insercion = actual[j-1] + penalidadGap;
+            actual[j] = std::max({coincidencia, eliminacion, insercion});
         }
     }
     
@@ -167,12 +172,12 @@ void compararResultadosDetallado(
         auto matriz_ref = calcularMatrizPuntuacion(secA, secB, config);
         
         // Verificar que la puntuación final coincide
-        if (matriz_ref[m][n] == resultado1.puntuacion && matriz_ref[m][n] == resultado2.puntuacion) {
+        if (matriz_ref(m, n) == resultado1.puntuacion && matriz_ref(m, n) == resultado2.puntuacion) {
             std::cout << "  ✓ Puntuación final F[" << m << "][" << n << "] = " 
-                      << matriz_ref[m][n] << " coincide con ambos métodos\n";
+                      << matriz_ref(m, n) << " coincide con ambos métodos\n";
         } else {
             std::cout << "  ✗ Inconsistencia en puntuación final:\n";
-            std::cout << "    Matriz referencia: " << matriz_ref[m][n] << "\n";
+            std::cout << "    Matriz referencia: " << matriz_ref(m, n) << "\n";
             std::cout << "    " << metodo1 << ": " << resultado1.puntuacion << "\n";
             std::cout << "    " << metodo2 << ": " << resultado2.puntuacion << "\n";
         }
@@ -204,43 +209,100 @@ void compararResultadosDetallado(
 }
 
 std::vector<std::string> leerArchivoFasta(const std::string& nombreArchivo) {
-    std::vector<std::string> secuencias;
-    std::ifstream archivo(nombreArchivo);
+    if (esArchivoSecuenciasBinario(nombreArchivo)) {
+        ArchivoSecuenciasBinario binario(nombreArchivo);
+        std::vector<std::string> secuencias(binario.registros());
+        long long registros = static_cast<long long>(secuencias.size());
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (long long r = 0; r < registros; ++r) {
+            secuencias[r] = binario.texto(r);
+        }
+        return secuencias;
+    }
+    
+    ArchivoFastaMapeado archivo(nombreArchivo);
+    std::vector<std::string> secuencias(archivo.registros());
+    long long registros = static_cast<long long>(secuencias.size());
     
-    if (!archivo.is_open()) {
-        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << "\n";
+    // Cada secuencia se copia una vez, ya sin saltos de línea, a su tamaño exacto
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long long r = 0; r < registros; ++r) {
+        secuencias[r] = archivo.secuencia(r);
+    }
+    return secuencias;
+}
+
+
+std::vector<SecuenciaDNA> leerArchivoFastaDNA(const std::string& nombreArchivo) {
+    if (esArchivoSecuenciasBinario(nombreArchivo)) {
+        // Ya empaquetado: cada registro es una copia de sus palabras
+        ArchivoSecuenciasBinario binario(nombreArchivo);
+        std::vector<SecuenciaDNA> secuencias(binario.registros());
+        long long registros = static_cast<long long>(secuencias.size());
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (long long r = 0; r < registros; ++r) {
+            secuencias[r] = binario.secuencia(r);
+        }
         return secuencias;
     }
     
-    std::string linea;
-    std::string secuencia_actual;
+    ArchivoFastaMapeado archivo(nombreArchivo);
+    std::vector<SecuenciaDNA> secuencias(archivo.registros());
+    long long registros = static_cast<long long>(secuencias.size());
     
-    while (std::getline(archivo, linea)) {
-        // Eliminar espacios en blanco al final
-        while (!linea.empty() && (linea.back() == '\r' || linea.back() == '\n')) {
-            linea.pop_back();
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long long r = 0; r < registros; ++r) {
+        secuencias[r] = archivo.empaquetar(r);
+    }
+    return secuencias;
+}
+
+LectorFasta::LectorFasta(const std::string& nombreArchivo) : registro_(0) {
+    if (esArchivoSecuenciasBinario(nombreArchivo)) {
+        binario_.reset(new ArchivoSecuenciasBinario(nombreArchivo));
+    } else {
+        archivo_.open(nombreArchivo);
+    }
+}
+
+LectorFasta::~LectorFasta() {}
+
+bool LectorFasta::abierto() const {
+    return binario_ ? binario_->abierto() : archivo_.is_open();
+}
+
+bool LectorFasta::siguiente(std::string& secuencia) {
+    secuencia.clear();
+    if (binario_) {
+        // Como en el FASTA de texto, los registros vacíos se saltan
+        while (secuencia.empty() && registro_ < binario_->registros()) {
+            secuencia = binario_->texto(registro_++);
+        }
+        return !secuencia.empty();
+    }
+    while (std::getline(archivo_, linea_)) {
+        while (!linea_.empty() && (linea_.back() == '\r' || linea_.back() == '\n')) {
+            linea_.pop_back();
         }
         
-        if (linea.empty()) continue;
+        if (linea_.empty()) continue;
         
-        if (linea[0] == '>') {
-            // Cabecera de nueva secuencia
-            if (!secuencia_actual.empty()) {
-                secuencias.push_back(secuencia_actual);
-                secuencia_actual.clear();
+        if (linea_[0] == '>') {
+            // La cabecera cierra la secuencia anterior (las vacías se saltan)
+            if (!secuencia.empty()) {
+                return true;
             }
         } else {
-            // Línea de secuencia
-            secuencia_actual += linea;
+            secuencia += linea_;
         }
     }
-    
-    // Agregar la última secuencia
-    if (!secuencia_actual.empty()) {
-        secuencias.push_back(secuencia_actual);
-    }
-    
-    archivo.close();
-    return secuencias;
+    return !secuencia.empty();
 }
-